@@ -0,0 +1,363 @@
+#ifndef JAC_BITSET_HPP
+#define JAC_BITSET_HPP
+
+/// @file
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <jac/option.hpp>
+
+namespace jac {
+
+/// @brief A runtime-sized sequence of bits with fast bulk operations
+///
+/// @details
+/// Unlike `std::vector<bool>`, `bitset` exposes its storage as 64-bit words
+/// and provides whole-set operations. The bulk operations (`&=`, `|=`, `^=`,
+/// `and_not`) are straight loops over contiguous words that compilers
+/// vectorize to the widest SIMD instructions available for the target, and
+/// `count` uses the hardware population count when it is enabled.
+///
+/// Bits past `size()` in the last word are always zero, so the words can be
+/// combined and counted without masking.
+class bitset {
+  private:
+    static constexpr size_t word_bits = 64;
+
+    std::vector<uint64_t> words_;
+    size_t size_{0};
+
+    static constexpr size_t word_count(size_t bits) noexcept {
+        return (bits + word_bits - 1) / word_bits;
+    }
+
+    void clear_tail() noexcept {
+        if (auto rem = size_ % word_bits; rem != 0) {
+            words_.back() &= (uint64_t{1} << rem) - 1;
+        }
+    }
+
+  public:
+    using size_type = size_t;
+    using word_type = uint64_t;
+
+    bitset() = default;
+
+    /// @brief Creates a bitset of `size` bits, all set to `value`
+    explicit bitset(size_type size, bool value = false)
+        : words_(word_count(size), value ? ~uint64_t{0} : 0), size_(size) {
+        clear_tail();
+    }
+
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Changes the number of bits, setting any new bits to `value`
+    void resize(size_type size, bool value = false) {
+        auto old = size_;
+        words_.resize(word_count(size), value ? ~uint64_t{0} : 0);
+        size_ = size;
+        if (value && size > old && old % word_bits != 0) {
+            words_[old / word_bits] |= ~uint64_t{0} << (old % word_bits);
+        }
+        clear_tail();
+    }
+
+    /// @brief The underlying words, least significant bit first
+    std::span<const word_type> words() const noexcept { return words_; }
+
+    bool test(size_type pos) const noexcept {
+        return (words_[pos / word_bits] >> (pos % word_bits)) & 1;
+    }
+
+    bool operator[](size_type pos) const noexcept { return test(pos); }
+
+    void set(size_type pos, bool value = true) noexcept {
+        auto mask = uint64_t{1} << (pos % word_bits);
+        auto& word = words_[pos / word_bits];
+        word = value ? (word | mask) : (word & ~mask);
+    }
+
+    void reset(size_type pos) noexcept { set(pos, false); }
+
+    void flip(size_type pos) noexcept {
+        words_[pos / word_bits] ^= uint64_t{1} << (pos % word_bits);
+    }
+
+    /// @brief Sets all bits
+    void set() noexcept {
+        std::fill(words_.begin(), words_.end(), ~uint64_t{0});
+        clear_tail();
+    }
+
+    /// @brief Clears all bits
+    void reset() noexcept { std::fill(words_.begin(), words_.end(), 0); }
+
+    /// @brief Flips all bits
+    void flip() noexcept {
+        for (auto& w : words_) { w = ~w; }
+        clear_tail();
+    }
+
+    /// @brief Number of set bits
+    size_type count() const noexcept {
+        size_type n = 0;
+        for (auto w : words_) { n += static_cast<size_type>(std::popcount(w)); }
+        return n;
+    }
+
+    bool any() const noexcept {
+        return std::any_of(words_.begin(), words_.end(),
+                           [](uint64_t w) { return w != 0; });
+    }
+
+    bool none() const noexcept { return !any(); }
+
+    bool all() const noexcept { return count() == size_; }
+
+    /// @brief Finds the first set bit at or after `pos`
+    option<size_type> find_next_set(size_type pos) const noexcept {
+        if (pos >= size_) { return null; }
+        auto idx = pos / word_bits;
+        auto word = words_[idx] & (~uint64_t{0} << (pos % word_bits));
+        while (word == 0) {
+            if (++idx == words_.size()) { return null; }
+            word = words_[idx];
+        }
+        return idx * word_bits + static_cast<size_type>(std::countr_zero(word));
+    }
+
+    /// @brief Finds the first clear bit at or after `pos`
+    option<size_type> find_next_unset(size_type pos) const noexcept {
+        if (pos >= size_) { return null; }
+        auto idx = pos / word_bits;
+        auto word = ~words_[idx] & (~uint64_t{0} << (pos % word_bits));
+        while (word == 0) {
+            if (++idx == words_.size()) { return null; }
+            word = ~words_[idx];
+        }
+        auto found =
+            idx * word_bits + static_cast<size_type>(std::countr_zero(word));
+        return found < size_ ? option<size_type>(found) : null;
+    }
+
+    option<size_type> find_first_set() const noexcept {
+        return find_next_set(0);
+    }
+
+    /// @brief Calls `f` with the position of each set bit in ascending order
+    template <typename F>
+    void for_each_set(F&& f) const {
+        for (size_type i = 0; i < words_.size(); ++i) {
+            for (auto w = words_[i]; w != 0; w &= w - 1) {
+                f(i * word_bits + static_cast<size_type>(std::countr_zero(w)));
+            }
+        }
+    }
+
+    /// @brief Intersects with `other`, which must be the same size
+    bitset& operator&=(const bitset& other) noexcept {
+        auto dst = words_.data();
+        auto src = other.words_.data();
+        for (size_type i = 0; i < words_.size(); ++i) { dst[i] &= src[i]; }
+        return *this;
+    }
+
+    /// @brief Unites with `other`, which must be the same size
+    bitset& operator|=(const bitset& other) noexcept {
+        auto dst = words_.data();
+        auto src = other.words_.data();
+        for (size_type i = 0; i < words_.size(); ++i) { dst[i] |= src[i]; }
+        return *this;
+    }
+
+    /// @brief Takes the symmetric difference with `other`, which must be the
+    /// same size
+    bitset& operator^=(const bitset& other) noexcept {
+        auto dst = words_.data();
+        auto src = other.words_.data();
+        for (size_type i = 0; i < words_.size(); ++i) { dst[i] ^= src[i]; }
+        return *this;
+    }
+
+    /// @brief Clears every bit that is set in `other`, which must be the same
+    /// size
+    bitset& and_not(const bitset& other) noexcept {
+        auto dst = words_.data();
+        auto src = other.words_.data();
+        for (size_type i = 0; i < words_.size(); ++i) { dst[i] &= ~src[i]; }
+        return *this;
+    }
+
+    /// @brief Counts the bits set in both `*this` and `other` without
+    /// materializing the intersection
+    size_type count_and(const bitset& other) const noexcept {
+        size_type n = 0;
+        for (size_type i = 0; i < words_.size(); ++i) {
+            n += static_cast<size_type>(
+                std::popcount(words_[i] & other.words_[i]));
+        }
+        return n;
+    }
+
+    void swap(bitset& other) noexcept {
+        words_.swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+    friend bitset operator&(bitset lhs, const bitset& rhs) noexcept {
+        lhs &= rhs;
+        return lhs;
+    }
+
+    friend bitset operator|(bitset lhs, const bitset& rhs) noexcept {
+        lhs |= rhs;
+        return lhs;
+    }
+
+    friend bitset operator^(bitset lhs, const bitset& rhs) noexcept {
+        lhs ^= rhs;
+        return lhs;
+    }
+
+    friend bitset operator~(bitset value) noexcept {
+        value.flip();
+        return value;
+    }
+
+    friend bool operator==(const bitset& lhs,
+                           const bitset& rhs) noexcept = default;
+};
+
+inline void swap(bitset& lhs, bitset& rhs) noexcept { lhs.swap(rhs); }
+
+/// @brief A succinct index over a `bitset` answering rank and select queries
+///
+/// @details
+/// `rank(pos)` counts the set bits before `pos` in constant time, using a
+/// cumulative count per 512-bit block plus at most eight word popcounts.
+/// `select(k)` finds the position of the `k`-th set bit, starting from a
+/// sampled block recorded for every 512th set bit, so only a few blocks are
+/// scanned in practice, and `select_zero(k)` does the same for clear bits.
+/// The index takes about 1/8 of the bitset's size plus the samples.
+///
+/// The index refers to the bitset it was built from, and is invalidated when
+/// that bitset is modified or destroyed.
+class rank_select_index {
+  private:
+    static constexpr size_t block_words = 8;
+    static constexpr size_t block_bits = block_words * 64;
+    static constexpr size_t sample_rate = 512;
+
+    std::span<const uint64_t> words_;
+    size_t size_;
+    // Number of set bits before each block, plus the total at the end
+    std::vector<uint64_t> block_ranks_;
+    // Block containing every `sample_rate`-th set bit
+    std::vector<uint32_t> samples_;
+    // Block containing every `sample_rate`-th clear bit
+    std::vector<uint32_t> zero_samples_;
+
+    template <bool Ones>
+    uint64_t count_before(size_t block) const noexcept {
+        auto ones = block_ranks_[block];
+        return Ones ? ones : block * block_bits - ones;
+    }
+
+    template <bool Ones>
+    option<size_t> select_impl(size_t k,
+                               const std::vector<uint32_t>& samples) const {
+        auto total = Ones ? count() : size_ - count();
+        if (k >= total) { return null; }
+        size_t block = samples[k / sample_rate];
+        while (block + 1 < block_ranks_.size() - 1 &&
+               count_before<Ones>(block + 1) <= k) {
+            ++block;
+        }
+
+        auto remaining = k - count_before<Ones>(block);
+        for (auto i = block * block_words;; ++i) {
+            auto w = Ones ? words_[i] : ~words_[i];
+            auto n = static_cast<uint64_t>(std::popcount(w));
+            if (remaining < n) {
+                for (; remaining > 0; --remaining) { w &= w - 1; }
+                return i * 64 + static_cast<size_t>(std::countr_zero(w));
+            }
+            remaining -= n;
+        }
+    }
+
+  public:
+    using size_type = size_t;
+
+    explicit rank_select_index(const bitset& bits)
+        : words_(bits.words()), size_(bits.size()) {
+        auto blocks = (words_.size() + block_words - 1) / block_words;
+        block_ranks_.reserve(blocks + 1);
+        uint64_t total = 0;
+        for (size_type b = 0; b < blocks; ++b) {
+            block_ranks_.push_back(total);
+            auto end = std::min(words_.size(), (b + 1) * block_words);
+            for (auto i = b * block_words; i < end; ++i) {
+                auto n = static_cast<uint64_t>(std::popcount(words_[i]));
+                // Record the block of each sampled bit crossed in this word
+                while (samples_.size() * sample_rate < total + n) {
+                    samples_.push_back(static_cast<uint32_t>(b));
+                }
+                auto zeros = i * 64 - total;
+                auto z = std::min<uint64_t>(64, size_ - i * 64) - n;
+                while (zero_samples_.size() * sample_rate < zeros + z) {
+                    zero_samples_.push_back(static_cast<uint32_t>(b));
+                }
+                total += n;
+            }
+        }
+        block_ranks_.push_back(total);
+    }
+
+    /// @brief Total number of set bits
+    size_type count() const noexcept {
+        return static_cast<size_type>(block_ranks_.back());
+    }
+
+    /// @brief Memory used by the block counts and samples, in bytes
+    size_type size_in_bytes() const noexcept {
+        return block_ranks_.size() * sizeof(uint64_t) +
+               (samples_.size() + zero_samples_.size()) * sizeof(uint32_t);
+    }
+
+    /// @brief Number of set bits in [0, `pos`), where `pos <= size()`
+    size_type rank(size_type pos) const noexcept {
+        auto word = pos / 64;
+        auto block = word / block_words;
+        auto n = block_ranks_[block];
+        for (auto i = block * block_words; i < word; ++i) {
+            n += static_cast<uint64_t>(std::popcount(words_[i]));
+        }
+        if (auto rem = pos % 64; rem != 0) {
+            n += static_cast<uint64_t>(
+                std::popcount(words_[word] & ((uint64_t{1} << rem) - 1)));
+        }
+        return static_cast<size_type>(n);
+    }
+
+    /// @brief Finds the position of the `k`-th set bit, counting from zero
+    option<size_type> select(size_type k) const noexcept {
+        return select_impl<true>(k, samples_);
+    }
+
+    /// @brief Finds the position of the `k`-th clear bit, counting from zero
+    option<size_type> select_zero(size_type k) const noexcept {
+        return select_impl<false>(k, zero_samples_);
+    }
+};
+
+} // namespace jac
+
+#endif
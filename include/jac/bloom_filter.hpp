@@ -0,0 +1,176 @@
+#ifndef JAC_BLOOM_FILTER_HPP
+#define JAC_BLOOM_FILTER_HPP
+
+/// @file
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <jac/macros.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+/// @brief A blocked Bloom filter that touches one cache line per query
+///
+/// @details
+/// A standard Bloom filter sets and tests `k` bits spread over the whole bit
+/// array, so every query takes up to `k` cache misses. `bloom_filter` instead
+/// maps each key to a single 256-bit block and sets exactly one bit in each of
+/// the block's eight 32-bit words. A query therefore reads one block, and the
+/// eight bit positions are computed with independent multiplications that
+/// compilers vectorize. The price is a slightly higher false positive rate for
+/// the same number of bits.
+///
+/// Keys are hashed with `Hash`, and the result is scrambled with
+/// `jac::hash_mix`, so identity hashes such as `std::hash<int>` work well.
+template <typename T, typename Hash = std::hash<T>>
+class bloom_filter {
+  private:
+    static constexpr size_t lanes = 8;
+    static constexpr size_t batch = 16;
+
+    static constexpr uint32_t salts[lanes] = {
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+        0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    struct alignas(32) block {
+        uint32_t words[lanes];
+    };
+
+    std::vector<block> blocks_;
+    JAC_NO_UNIQ_ADDR Hash hasher_;
+
+    uint64_t hash(const T& key) const { return hash_mix(hasher_(key)); }
+
+    const block& block_for(uint64_t h) const noexcept {
+        return blocks_[((h >> 32) * blocks_.size()) >> 32];
+    }
+
+    block& block_for(uint64_t h) noexcept {
+        return blocks_[((h >> 32) * blocks_.size()) >> 32];
+    }
+
+    static bool test(const block& blk, uint64_t h) noexcept {
+        auto key = static_cast<uint32_t>(h);
+        uint32_t missing = 0;
+        for (size_t i = 0; i < lanes; ++i) {
+            auto bit = uint32_t{1} << ((key * salts[i]) >> 27);
+            missing |= ~blk.words[i] & bit;
+        }
+        return missing == 0;
+    }
+
+  public:
+    using key_type = T;
+    using hasher = Hash;
+    using size_type = size_t;
+
+    /// @brief Creates a filter sized for `expected_items` keys at the given
+    /// target false positive rate
+    ///
+    /// @throws std::invalid_argument if `false_positive_rate` is not in (0, 1)
+    explicit bloom_filter(size_type expected_items,
+                          double false_positive_rate = 0.01,
+                          const Hash& hash = Hash())
+        : hasher_(hash) {
+        if (!(false_positive_rate > 0 && false_positive_rate < 1)) {
+            throw std::invalid_argument(
+                "invalid jac::bloom_filter false positive rate");
+        }
+        auto ln2 = std::log(2.0);
+        auto items = std::max<size_type>(expected_items, 1);
+        auto bits = -static_cast<double>(items) *
+                    std::log(false_positive_rate) / (ln2 * ln2);
+        auto count = static_cast<size_type>(std::ceil(bits / (lanes * 32)));
+        blocks_.resize(std::max<size_type>(count, 1));
+    }
+
+    /// @brief Size of the filter in bytes
+    size_type size_in_bytes() const noexcept {
+        return blocks_.size() * sizeof(block);
+    }
+
+    void clear() noexcept {
+        std::fill(blocks_.begin(), blocks_.end(), block{});
+    }
+
+    void insert(const T& key) {
+        auto h = hash(key);
+        auto& blk = block_for(h);
+        auto k = static_cast<uint32_t>(h);
+        for (size_t i = 0; i < lanes; ++i) {
+            blk.words[i] |= uint32_t{1} << ((k * salts[i]) >> 27);
+        }
+    }
+
+    /// @brief Checks if a key may have been inserted
+    ///
+    /// @details
+    /// A `false` result means the key was definitely never inserted.
+    bool may_contain(const T& key) const {
+        auto h = hash(key);
+        return test(block_for(h), h);
+    }
+
+    /// @brief Checks a batch of keys, writing each result to `out`
+    ///
+    /// @details
+    /// Keys are processed in groups whose blocks are all prefetched before any
+    /// of them are tested, so the cache misses of a group overlap instead of
+    /// being serialized. `out` must be at least as long as `keys`.
+    ///
+    /// @return The number of keys that may have been inserted
+    size_type may_contain_n(std::span<const T> keys,
+                            std::span<bool> out) const {
+        size_type hits = 0;
+        uint64_t hashes[batch];
+        for (size_type base = 0; base < keys.size(); base += batch) {
+            auto n = std::min(batch, keys.size() - base);
+            for (size_type i = 0; i < n; ++i) {
+                hashes[i] = hash(keys[base + i]);
+                JAC_PREFETCH(&block_for(hashes[i]));
+            }
+            for (size_type i = 0; i < n; ++i) {
+                auto found = test(block_for(hashes[i]), hashes[i]);
+                out[base + i] = found;
+                hits += found;
+            }
+        }
+        return hits;
+    }
+
+    /// @brief Merges the keys of another filter of the same size into this one
+    ///
+    /// @details
+    /// Both filters must also hash keys the same way. Hashers that can be
+    /// compared with `==`, such as seeded hashers, are checked.
+    ///
+    /// @throws std::invalid_argument if the sizes or the hashers differ
+    void merge(const bloom_filter& other) {
+        bool same_hash = true;
+        if constexpr (std::equality_comparable<Hash>) {
+            same_hash = hasher_ == other.hasher_;
+        }
+        if (other.blocks_.size() != blocks_.size() || !same_hash) {
+            throw std::invalid_argument(
+                "merging incompatible jac::bloom_filter filters");
+        }
+        for (size_type b = 0; b < blocks_.size(); ++b) {
+            for (size_t i = 0; i < lanes; ++i) {
+                blocks_[b].words[i] |= other.blocks_[b].words[i];
+            }
+        }
+    }
+};
+
+} // namespace jac
+
+#endif
@@ -0,0 +1,891 @@
+#ifndef JAC_BTREE_MAP_HPP
+#define JAC_BTREE_MAP_HPP
+
+/// @file
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <jac/macros.hpp>
+#include <jac/maybe_uninit.hpp>
+#include <jac/option.hpp>
+#include <jac/relocate.hpp>
+#include <jac/types.hpp>
+
+namespace jac {
+
+/// @brief An ordered map implemented as a cache-friendly B+tree
+///
+/// @details
+/// `btree_map` stores up to a node's worth of keys contiguously in each node,
+/// where the size of a node in bytes is given by `NodeSize`. The default of
+/// 256 bytes spans four cache lines, and larger values such as 4096 trade
+/// insertion cost for shallower trees. All elements live in the leaves, and
+/// the leaves are linked together so that iteration and range scans never
+/// need to walk back up the tree.
+///
+/// When `K` is an arithmetic type ordered by `std::less`, searching within a
+/// node is a branchless count over the contiguous keys, which compilers turn
+/// into SIMD comparisons. Other keys use a binary search within each node.
+///
+/// Inner nodes hold copies of keys as separators, so `K` must be copy
+/// constructible. Elements are shifted within nodes by relocation, so `K` and
+/// `V` must either be trivially relocatable or nothrow move constructible.
+/// Inserting into or erasing from the map invalidates all iterators.
+template <typename K,
+          typename V,
+          typename Compare = std::less<K>,
+          size_t NodeSize = 256>
+class btree_map {
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using key_compare = Compare;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = std::pair<const K&, V&>;
+    using const_reference = std::pair<const K&, const V&>;
+
+    /// @brief Maximum number of elements stored in a leaf node
+    static constexpr size_type leaf_capacity = std::max<size_type>(
+        4,
+        (NodeSize - 2 * sizeof(void*)) / (sizeof(K) + sizeof(V)));
+
+    /// @brief Maximum number of keys stored in an inner node
+    static constexpr size_type inner_capacity = std::max<size_type>(
+        4,
+        (NodeSize - 2 * sizeof(void*)) / (sizeof(K) + sizeof(void*)));
+
+  private:
+    static_assert(std::is_copy_constructible_v<K>);
+    static_assert(is_trivially_relocatable_v<K> ||
+                  std::is_nothrow_move_constructible_v<K>);
+    static_assert(is_trivially_relocatable_v<V> ||
+                  std::is_nothrow_move_constructible_v<V>);
+    static_assert(NodeSize > 4 * sizeof(void*));
+    static_assert(leaf_capacity <= UINT16_MAX && inner_capacity <= UINT16_MAX);
+
+    static constexpr size_type min_leaf = leaf_capacity / 2;
+    static constexpr size_type min_inner = (inner_capacity - 1) / 2;
+    static constexpr size_type max_depth = 64;
+
+    static constexpr bool linear_search =
+        std::is_arithmetic_v<K> && (std::is_same_v<Compare, std::less<K>> ||
+                                    std::is_same_v<Compare, std::less<>>);
+
+    struct node {
+        uint16_t size;
+        bool leaf;
+    };
+
+    struct leaf_node : node {
+        leaf_node* next{nullptr};
+        maybe_uninit<K[leaf_capacity]> keys;
+        maybe_uninit<V[leaf_capacity]> values;
+
+        leaf_node() : node{0, true} {}
+    };
+
+    struct inner_node : node {
+        maybe_uninit<K[inner_capacity]> keys;
+        node* children[inner_capacity + 1];
+
+        inner_node() : node{0, false} {}
+    };
+
+    struct path_entry {
+        inner_node* node;
+        size_type index;
+    };
+
+    node* root_{nullptr};
+    leaf_node* first_{nullptr};
+    size_type size_{0};
+    JAC_NO_UNIQ_ADDR Compare comp_;
+
+    static K* keys_of(leaf_node* n) noexcept { return n->keys.value(); }
+
+    static K* keys_of(inner_node* n) noexcept { return n->keys.value(); }
+
+    static V* values_of(leaf_node* n) noexcept { return n->values.value(); }
+
+    static leaf_node* as_leaf(node* n) noexcept {
+        return static_cast<leaf_node*>(n);
+    }
+
+    static inner_node* as_inner(node* n) noexcept {
+        return static_cast<inner_node*>(n);
+    }
+
+    static leaf_node* new_leaf() {
+        return std::construct_at(std::allocator<leaf_node>{}.allocate(1));
+    }
+
+    static inner_node* new_inner() {
+        return std::construct_at(std::allocator<inner_node>{}.allocate(1));
+    }
+
+    static void free_node(node* n) noexcept {
+        if (n->leaf) {
+            std::destroy_at(as_leaf(n));
+            std::allocator<leaf_node>{}.deallocate(as_leaf(n), 1);
+        } else {
+            std::destroy_at(as_inner(n));
+            std::allocator<inner_node>{}.deallocate(as_inner(n), 1);
+        }
+    }
+
+    static void destroy_tree(node* n) noexcept {
+        if (n->leaf) {
+            auto leaf = as_leaf(n);
+            std::destroy_n(keys_of(leaf), leaf->size);
+            std::destroy_n(values_of(leaf), leaf->size);
+        } else {
+            auto inner = as_inner(n);
+            std::destroy_n(keys_of(inner), inner->size);
+            for (size_type i = 0; i <= inner->size; ++i) {
+                destroy_tree(inner->children[i]);
+            }
+        }
+        free_node(n);
+    }
+
+    // Index of the first key that is not less than `key`
+    size_type lower_index(const K* keys,
+                          size_type n,
+                          const K& key) const noexcept {
+        if constexpr (linear_search) {
+            size_type count = 0;
+            for (size_type i = 0; i < n; ++i) {
+                count += static_cast<size_type>(keys[i] < key);
+            }
+            return count;
+        } else {
+            return static_cast<size_type>(
+                std::lower_bound(keys, keys + n, key, comp_) - keys);
+        }
+    }
+
+    // Index of the first key that is greater than `key`
+    size_type upper_index(const K* keys,
+                          size_type n,
+                          const K& key) const noexcept {
+        if constexpr (linear_search) {
+            size_type count = 0;
+            for (size_type i = 0; i < n; ++i) {
+                count += static_cast<size_type>(!(key < keys[i]));
+            }
+            return count;
+        } else {
+            return static_cast<size_type>(
+                std::upper_bound(keys, keys + n, key, comp_) - keys);
+        }
+    }
+
+    leaf_node* find_leaf(const K& key) const noexcept {
+        auto n = root_;
+        while (!n->leaf) {
+            auto inner = as_inner(n);
+            n = inner->children[upper_index(keys_of(inner), inner->size, key)];
+        }
+        return as_leaf(n);
+    }
+
+    leaf_node* find_leaf(const K& key,
+                         path_entry* path,
+                         size_type& depth) const noexcept {
+        auto n = root_;
+        depth = 0;
+        while (!n->leaf) {
+            auto inner = as_inner(n);
+            auto idx = upper_index(keys_of(inner), inner->size, key);
+            path[depth++] = {inner, idx};
+            n = inner->children[idx];
+        }
+        return as_leaf(n);
+    }
+
+    // Opens a gap at `pos` in a leaf with spare capacity
+    static void open_gap(leaf_node* leaf, size_type pos) noexcept {
+        auto keys = keys_of(leaf);
+        auto values = values_of(leaf);
+        uninitialized_relocate_backward(keys + pos, keys + leaf->size,
+                                        keys + leaf->size + 1);
+        uninitialized_relocate_backward(values + pos, values + leaf->size,
+                                        values + leaf->size + 1);
+    }
+
+    // Closes a gap at `pos` in a leaf, where the size does not include the gap
+    static void close_gap(leaf_node* leaf, size_type pos) noexcept {
+        auto keys = keys_of(leaf);
+        auto values = values_of(leaf);
+        uninitialized_relocate(keys + pos + 1, keys + leaf->size + 1,
+                               keys + pos);
+        uninitialized_relocate(values + pos + 1, values + leaf->size + 1,
+                               values + pos);
+    }
+
+    // Relocates a separator into an inner node with spare capacity and inserts
+    // the child to its right
+    static void inner_insert(inner_node* inner,
+                             size_type idx,
+                             K* sep,
+                             node* child) noexcept {
+        auto keys = keys_of(inner);
+        uninitialized_relocate_backward(keys + idx, keys + inner->size,
+                                        keys + inner->size + 1);
+        relocate(sep, keys + idx);
+        std::copy_backward(inner->children + idx + 1,
+                           inner->children + inner->size + 1,
+                           inner->children + inner->size + 2);
+        inner->children[idx + 1] = child;
+        ++inner->size;
+    }
+
+    // Removes the key at `idx`, which has already been destroyed or relocated
+    // out, and the child to its right from an inner node
+    static void inner_remove(inner_node* inner, size_type idx) noexcept {
+        auto keys = keys_of(inner);
+        uninitialized_relocate(keys + idx + 1, keys + inner->size, keys + idx);
+        std::copy(inner->children + idx + 2, inner->children + inner->size + 1,
+                  inner->children + idx + 1);
+        --inner->size;
+    }
+
+    // Splits a full leaf, moving its upper half into `right`
+    void split_leaf(leaf_node* leaf, leaf_node* right) noexcept {
+        constexpr size_type mid = (leaf_capacity + 1) / 2;
+        uninitialized_relocate(keys_of(leaf) + mid,
+                               keys_of(leaf) + leaf_capacity, keys_of(right));
+        uninitialized_relocate(values_of(leaf) + mid,
+                               values_of(leaf) + leaf_capacity,
+                               values_of(right));
+        leaf->size = mid;
+        right->size = leaf_capacity - mid;
+        right->next = leaf->next;
+        leaf->next = right;
+    }
+
+    // Splits a full inner node, moving its upper half into `right` and
+    // relocating the middle key into `sep`
+    static void split_inner(inner_node* inner,
+                            inner_node* right,
+                            K* sep) noexcept {
+        constexpr size_type mid = inner_capacity / 2;
+        auto keys = keys_of(inner);
+        relocate(keys + mid, sep);
+        uninitialized_relocate(keys + mid + 1, keys + inner_capacity,
+                               keys_of(right));
+        std::copy(inner->children + mid + 1,
+                  inner->children + inner_capacity + 1, right->children);
+        inner->size = mid;
+        right->size = inner_capacity - mid - 1;
+    }
+
+    // Inserts a new element at `pos` in `leaf`, splitting nodes along `path`
+    // as needed. Everything that can fail is done before the tree is
+    // modified, so a failed split leaves the tree untouched.
+    template <typename KK, typename... Args>
+    std::pair<leaf_node*, size_type> insert_at(leaf_node* leaf,
+                                               size_type pos,
+                                               path_entry* path,
+                                               size_type depth,
+                                               KK&& key,
+                                               Args&&... args) {
+        auto target = leaf;
+        if (leaf->size == leaf_capacity) {
+            // One inner node for each full ancestor, plus a new root if
+            // every ancestor is full
+            size_type inners = 0;
+            while (inners < depth &&
+                   path[depth - inners - 1].node->size == inner_capacity) {
+                ++inners;
+            }
+            if (inners == depth) { ++inners; }
+
+            constexpr size_type mid = (leaf_capacity + 1) / 2;
+            inner_node* spares[max_depth + 1];
+            size_type spare_count = 0;
+            leaf_node* right_leaf = nullptr;
+            maybe_uninit<K> sep;
+            try {
+                right_leaf = new_leaf();
+                for (; spare_count < inners; ++spare_count) {
+                    spares[spare_count] = new_inner();
+                }
+                sep.construct(keys_of(leaf)[mid]);
+            } catch (...) {
+                while (spare_count != 0) { free_node(spares[--spare_count]); }
+                if (right_leaf != nullptr) { free_node(right_leaf); }
+                throw;
+            }
+
+            split_leaf(leaf, right_leaf);
+            if (pos > leaf->size) {
+                target = right_leaf;
+                pos -= leaf->size;
+            }
+
+            node* child = right_leaf;
+            size_type level = depth;
+            size_type spare = 0;
+            while (true) {
+                if (level == 0) {
+                    auto root = spares[spare++];
+                    relocate(sep.data(), keys_of(root));
+                    root->children[0] = root_;
+                    root->children[1] = child;
+                    root->size = 1;
+                    root_ = root;
+                    break;
+                }
+                auto [parent, idx] = path[--level];
+                if (parent->size < inner_capacity) {
+                    inner_insert(parent, idx, sep.data(), child);
+                    break;
+                }
+                auto right = spares[spare++];
+                maybe_uninit<K> up;
+                split_inner(parent, right, up.data());
+                if (idx <= parent->size) {
+                    inner_insert(parent, idx, sep.data(), child);
+                } else {
+                    inner_insert(right, idx - parent->size - 1, sep.data(),
+                                 child);
+                }
+                relocate(up.data(), sep.data());
+                child = right;
+            }
+        }
+
+        open_gap(target, pos);
+        try {
+            std::construct_at(keys_of(target) + pos, std::forward<KK>(key));
+            try {
+                std::construct_at(values_of(target) + pos,
+                                  std::forward<Args>(args)...);
+            } catch (...) {
+                std::destroy_at(keys_of(target) + pos);
+                throw;
+            }
+        } catch (...) {
+            close_gap(target, pos);
+            throw;
+        }
+        ++target->size;
+        ++size_;
+        return {target, pos};
+    }
+
+    template <typename KK, typename... Args>
+    std::pair<leaf_node*, size_type> emplace_unique(bool& inserted,
+                                                    KK&& key,
+                                                    Args&&... args) {
+        if (root_ == nullptr) { root_ = first_ = new_leaf(); }
+        path_entry path[max_depth];
+        size_type depth;
+        auto leaf = find_leaf(key, path, depth);
+        auto pos = lower_index(keys_of(leaf), leaf->size, key);
+        if (pos < leaf->size && !comp_(key, keys_of(leaf)[pos])) {
+            inserted = false;
+            return {leaf, pos};
+        }
+        inserted = true;
+        return insert_at(leaf, pos, path, depth, std::forward<KK>(key),
+                         std::forward<Args>(args)...);
+    }
+
+    void rebalance_leaf(leaf_node* leaf, path_entry* path, size_type depth) {
+        if (depth == 0) {
+            if (leaf->size == 0) {
+                free_node(leaf);
+                root_ = first_ = nullptr;
+            }
+            return;
+        }
+        if (leaf->size >= min_leaf) { return; }
+
+        auto [parent, idx] = path[depth - 1];
+        auto pkeys = keys_of(parent);
+        if (idx > 0) {
+            auto left = as_leaf(parent->children[idx - 1]);
+            if (left->size > min_leaf) {
+                open_gap(leaf, 0);
+                relocate(keys_of(left) + left->size - 1, keys_of(leaf));
+                relocate(values_of(left) + left->size - 1, values_of(leaf));
+                --left->size;
+                ++leaf->size;
+                pkeys[idx - 1] = keys_of(leaf)[0];
+                return;
+            }
+        }
+        if (idx < parent->size) {
+            auto right = as_leaf(parent->children[idx + 1]);
+            if (right->size > min_leaf) {
+                relocate(keys_of(right), keys_of(leaf) + leaf->size);
+                relocate(values_of(right), values_of(leaf) + leaf->size);
+                --right->size;
+                ++leaf->size;
+                close_gap(right, 0);
+                pkeys[idx] = keys_of(right)[0];
+                return;
+            }
+        }
+
+        auto sep_idx = idx > 0 ? idx - 1 : idx;
+        auto left = as_leaf(parent->children[sep_idx]);
+        auto right = as_leaf(parent->children[sep_idx + 1]);
+        uninitialized_relocate_n(keys_of(right), right->size,
+                                 keys_of(left) + left->size);
+        uninitialized_relocate_n(values_of(right), right->size,
+                                 values_of(left) + left->size);
+        left->size += right->size;
+        left->next = right->next;
+        free_node(right);
+        std::destroy_at(pkeys + sep_idx);
+        inner_remove(parent, sep_idx);
+        rebalance_inner(path, depth - 1);
+    }
+
+    void rebalance_inner(path_entry* path, size_type depth) noexcept {
+        while (true) {
+            auto inner = path[depth].node;
+            if (depth == 0) {
+                if (inner->size == 0) {
+                    root_ = inner->children[0];
+                    free_node(inner);
+                }
+                return;
+            }
+            if (inner->size >= min_inner) { return; }
+
+            auto [parent, idx] = path[depth - 1];
+            auto pkeys = keys_of(parent);
+            if (idx > 0) {
+                auto left = as_inner(parent->children[idx - 1]);
+                if (left->size > min_inner) {
+                    auto keys = keys_of(inner);
+                    uninitialized_relocate_backward(keys, keys + inner->size,
+                                                    keys + inner->size + 1);
+                    std::copy_backward(inner->children,
+                                       inner->children + inner->size + 1,
+                                       inner->children + inner->size + 2);
+                    relocate(pkeys + idx - 1, keys);
+                    relocate(keys_of(left) + left->size - 1, pkeys + idx - 1);
+                    inner->children[0] = left->children[left->size];
+                    --left->size;
+                    ++inner->size;
+                    return;
+                }
+            }
+            if (idx < parent->size) {
+                auto right = as_inner(parent->children[idx + 1]);
+                if (right->size > min_inner) {
+                    relocate(pkeys + idx, keys_of(inner) + inner->size);
+                    inner->children[inner->size + 1] = right->children[0];
+                    ++inner->size;
+                    relocate(keys_of(right), pkeys + idx);
+                    uninitialized_relocate(keys_of(right) + 1,
+                                           keys_of(right) + right->size,
+                                           keys_of(right));
+                    std::copy(right->children + 1,
+                              right->children + right->size + 1,
+                              right->children);
+                    --right->size;
+                    return;
+                }
+            }
+
+            auto sep_idx = idx > 0 ? idx - 1 : idx;
+            auto left = as_inner(parent->children[sep_idx]);
+            auto right = as_inner(parent->children[sep_idx + 1]);
+            relocate(pkeys + sep_idx, keys_of(left) + left->size);
+            uninitialized_relocate_n(keys_of(right), right->size,
+                                     keys_of(left) + left->size + 1);
+            std::copy(right->children, right->children + right->size + 1,
+                      left->children + left->size + 1);
+            left->size += right->size + 1;
+            free_node(right);
+            inner_remove(parent, sep_idx);
+            --depth;
+        }
+    }
+
+    // Builds the tree from sorted, unique input. The map must be empty.
+    template <typename It, typename Sent>
+    void bulk_load(It first, Sent last) {
+        leaf_node* tail = nullptr;
+        size_type leaf_count = 0;
+        try {
+            for (; first != last; ++first) {
+                if (tail == nullptr || tail->size == leaf_capacity) {
+                    auto leaf = new_leaf();
+                    if (tail == nullptr) {
+                        first_ = leaf;
+                    } else {
+                        tail->next = leaf;
+                    }
+                    tail = leaf;
+                    ++leaf_count;
+                }
+                auto&& [key, value] = *first;
+                std::construct_at(keys_of(tail) + tail->size, key);
+                try {
+                    std::construct_at(values_of(tail) + tail->size, value);
+                } catch (...) {
+                    std::destroy_at(keys_of(tail) + tail->size);
+                    throw;
+                }
+                ++tail->size;
+                ++size_;
+            }
+        } catch (...) {
+            while (first_ != nullptr) {
+                auto next = first_->next;
+                destroy_tree(first_);
+                first_ = next;
+            }
+            size_ = 0;
+            throw;
+        }
+        if (first_ == nullptr) { return; }
+
+        std::vector<std::pair<node*, const K*>> level;
+        level.reserve(leaf_count);
+        leaf_node* prev = nullptr;
+        for (auto leaf = first_; leaf != nullptr; leaf = leaf->next) {
+            if (leaf->next == nullptr && prev != nullptr &&
+                leaf->size < min_leaf) {
+                // Even out the last two leaves so both meet the minimum
+                auto total = prev->size + leaf->size;
+                auto move = prev->size - total / 2;
+                uninitialized_relocate_backward(keys_of(leaf),
+                                                keys_of(leaf) + leaf->size,
+                                                keys_of(leaf) + leaf->size +
+                                                    move);
+                uninitialized_relocate_backward(values_of(leaf),
+                                                values_of(leaf) + leaf->size,
+                                                values_of(leaf) + leaf->size +
+                                                    move);
+                uninitialized_relocate_n(keys_of(prev) + prev->size - move,
+                                         move, keys_of(leaf));
+                uninitialized_relocate_n(values_of(prev) + prev->size - move,
+                                         move, values_of(leaf));
+                prev->size -= static_cast<uint16_t>(move);
+                leaf->size += static_cast<uint16_t>(move);
+            }
+            level.emplace_back(leaf, keys_of(leaf));
+            prev = leaf;
+        }
+
+        std::vector<inner_node*> built;
+        try {
+            while (level.size() > 1) {
+                auto count = level.size();
+                auto groups = (count + inner_capacity) / (inner_capacity + 1);
+                std::vector<std::pair<node*, const K*>> next_level;
+                next_level.reserve(groups);
+                size_type at = 0;
+                for (size_type g = 0; g < groups; ++g) {
+                    auto n = count / groups + (g < count % groups ? 1 : 0);
+                    auto inner = new_inner();
+                    built.push_back(inner);
+                    inner->children[0] = level[at].first;
+                    for (size_type i = 1; i < n; ++i) {
+                        std::construct_at(keys_of(inner) + i - 1,
+                                          *level[at + i].second);
+                        inner->children[i] = level[at + i].first;
+                        inner->size = static_cast<uint16_t>(i);
+                    }
+                    next_level.emplace_back(inner, level[at].second);
+                    at += n;
+                }
+                level = std::move(next_level);
+            }
+        } catch (...) {
+            for (auto inner : built) {
+                std::destroy_n(keys_of(inner), inner->size);
+                free_node(inner);
+            }
+            while (first_ != nullptr) {
+                auto next = first_->next;
+                destroy_tree(first_);
+                first_ = next;
+            }
+            size_ = 0;
+            throw;
+        }
+        root_ = level.front().first;
+    }
+
+    template <bool Const>
+    class basic_iterator {
+      private:
+        friend class btree_map;
+
+        leaf_node* leaf_{nullptr};
+        size_type idx_{0};
+
+        basic_iterator(leaf_node* leaf, size_type idx) noexcept
+            : leaf_(leaf), idx_(idx) {}
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = std::pair<K, V>;
+        using reference = std::conditional_t<Const,
+                                             btree_map::const_reference,
+                                             btree_map::reference>;
+
+        struct pointer {
+            reference ref;
+
+            reference* operator->() noexcept { return &ref; }
+        };
+
+        basic_iterator() = default;
+
+        template <bool C = Const>
+            requires(C)
+        basic_iterator(const basic_iterator<false>& other) noexcept
+            : leaf_(other.leaf_), idx_(other.idx_) {}
+
+        reference operator*() const noexcept {
+            return {keys_of(leaf_)[idx_], values_of(leaf_)[idx_]};
+        }
+
+        pointer operator->() const noexcept { return pointer{**this}; }
+
+        basic_iterator& operator++() noexcept {
+            if (++idx_ == leaf_->size) {
+                leaf_ = leaf_->next;
+                idx_ = 0;
+            }
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        friend bool operator==(const basic_iterator& lhs,
+                               const basic_iterator& rhs) noexcept {
+            return lhs.leaf_ == rhs.leaf_ && lhs.idx_ == rhs.idx_;
+        }
+    };
+
+  public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    btree_map() = default;
+
+    explicit btree_map(const Compare& comp) : comp_(comp) {}
+
+    /// @brief Bulk-loads the map from input sorted by key without duplicates
+    ///
+    /// @details
+    /// The input is consumed in a single pass and packed into full leaves,
+    /// which is much faster than inserting each element and produces a denser
+    /// tree.
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    btree_map([[maybe_unused]] sorted_unique_t tag,
+              It first,
+              Sent last,
+              const Compare& comp = Compare())
+        : comp_(comp) {
+        bulk_load(std::move(first), std::move(last));
+    }
+
+    btree_map(sorted_unique_t tag,
+              std::initializer_list<std::pair<K, V>> ilist,
+              const Compare& comp = Compare())
+        : btree_map(tag, ilist.begin(), ilist.end(), comp) {}
+
+    btree_map(std::initializer_list<std::pair<K, V>> ilist,
+              const Compare& comp = Compare())
+        : comp_(comp) {
+        for (auto& [key, value] : ilist) { try_emplace(key, value); }
+    }
+
+    btree_map(const btree_map& other) : comp_(other.comp_) {
+        bulk_load(other.begin(), other.end());
+    }
+
+    btree_map(btree_map&& other) noexcept
+        : root_(std::exchange(other.root_, nullptr)),
+          first_(std::exchange(other.first_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          comp_(std::move(other.comp_)) {}
+
+    ~btree_map() { clear(); }
+
+    btree_map& operator=(const btree_map& other) {
+        if (this != &other) {
+            btree_map tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    btree_map& operator=(btree_map&& other) noexcept {
+        btree_map tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    void clear() noexcept {
+        if (root_ != nullptr) { destroy_tree(root_); }
+        root_ = nullptr;
+        first_ = nullptr;
+        size_ = 0;
+    }
+
+    iterator begin() noexcept { return iterator(first_, 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(first_, 0); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(); }
+
+    const_iterator end() const noexcept { return const_iterator(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    option<V&> find(const K& key) noexcept {
+        if (root_ == nullptr) { return null; }
+        auto leaf = find_leaf(key);
+        auto pos = lower_index(keys_of(leaf), leaf->size, key);
+        if (pos < leaf->size && !comp_(key, keys_of(leaf)[pos])) {
+            return option<V&>(values_of(leaf)[pos]);
+        }
+        return null;
+    }
+
+    option<const V&> find(const K& key) const noexcept {
+        return const_cast<btree_map*>(this)->find(key).transform(
+            [](V& value) -> const V& { return value; });
+    }
+
+    bool contains(const K& key) const noexcept {
+        return find(key).has_value();
+    }
+
+    /// @brief Gets an iterator to the first element whose key is not less
+    /// than `key`, if there is one
+    option<iterator> lower_bound(const K& key) noexcept {
+        if (root_ == nullptr) { return null; }
+        auto leaf = find_leaf(key);
+        auto pos = lower_index(keys_of(leaf), leaf->size, key);
+        if (pos == leaf->size) {
+            if (leaf->next == nullptr) { return null; }
+            return iterator(leaf->next, 0);
+        }
+        return iterator(leaf, pos);
+    }
+
+    /// @copydoc lower_bound
+    option<const_iterator> lower_bound(const K& key) const noexcept {
+        return const_cast<btree_map*>(this)->lower_bound(key).transform(
+            [](iterator it) { return const_iterator(it); });
+    }
+
+    /// @brief Gets an iterator to the first element whose key is greater
+    /// than `key`, if there is one
+    option<iterator> upper_bound(const K& key) noexcept {
+        if (root_ == nullptr) { return null; }
+        auto leaf = find_leaf(key);
+        auto pos = upper_index(keys_of(leaf), leaf->size, key);
+        if (pos == leaf->size) {
+            if (leaf->next == nullptr) { return null; }
+            return iterator(leaf->next, 0);
+        }
+        return iterator(leaf, pos);
+    }
+
+    /// @copydoc upper_bound
+    option<const_iterator> upper_bound(const K& key) const noexcept {
+        return const_cast<btree_map*>(this)->upper_bound(key).transform(
+            [](iterator it) { return const_iterator(it); });
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+        bool inserted;
+        auto [leaf, pos] =
+            emplace_unique(inserted, key, std::forward<Args>(args)...);
+        return {iterator(leaf, pos), inserted};
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        bool inserted;
+        auto [leaf, pos] = emplace_unique(inserted, std::move(key),
+                                          std::forward<Args>(args)...);
+        return {iterator(leaf, pos), inserted};
+    }
+
+    template <typename U>
+    std::pair<iterator, bool> insert(const K& key, U&& value) {
+        return try_emplace(key, std::forward<U>(value));
+    }
+
+    template <typename U>
+    std::pair<iterator, bool> insert_or_assign(const K& key, U&& value) {
+        auto ret = try_emplace(key, std::forward<U>(value));
+        if (!ret.second) { ret.first->second = std::forward<U>(value); }
+        return ret;
+    }
+
+    V& operator[](const K& key) { return try_emplace(key).first->second; }
+
+    /// @brief Removes the element with the given key, returning its value
+    option<V> erase(const K& key) {
+        if (root_ == nullptr) { return null; }
+        path_entry path[max_depth];
+        size_type depth;
+        auto leaf = find_leaf(key, path, depth);
+        auto pos = lower_index(keys_of(leaf), leaf->size, key);
+        if (pos == leaf->size || comp_(key, keys_of(leaf)[pos])) {
+            return null;
+        }
+        option<V> ret(std::move(values_of(leaf)[pos]));
+        std::destroy_at(keys_of(leaf) + pos);
+        std::destroy_at(values_of(leaf) + pos);
+        --leaf->size;
+        --size_;
+        close_gap(leaf, pos);
+        rebalance_leaf(leaf, path, depth);
+        return ret;
+    }
+
+    key_compare key_comp() const { return comp_; }
+
+    void swap(btree_map& other) noexcept {
+        using std::swap;
+        swap(root_, other.root_);
+        swap(first_, other.first_);
+        swap(size_, other.size_);
+        swap(comp_, other.comp_);
+    }
+
+    friend void swap(btree_map& a, btree_map& b) noexcept { a.swap(b); }
+};
+
+} // namespace jac
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef JAC_CLOCK_CACHE_HPP
+#define JAC_CLOCK_CACHE_HPP
+
+/// @file
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <jac/macros.hpp>
+#include <jac/option.hpp>
+#include <jac/result.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+/// @brief A fixed-size cache that approximates LRU eviction with the CLOCK
+/// algorithm
+///
+/// @details
+/// `clock_cache` trades the exact recency order of `lru_cache` for lower
+/// overhead. All entries live in one array allocated up front, indexed by a
+/// flat open-addressing table of 32-bit slot numbers, and a hit only sets a
+/// flag on the entry instead of relinking it. To evict, a hand sweeps the
+/// array, clearing flags until it finds an entry that has not been used
+/// since the last pass.
+///
+/// The capacity is a number of entries. References returned by the cache
+/// stay valid until their entry is evicted or erased.
+template <typename K,
+          typename V,
+          typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class clock_cache {
+  private:
+    static constexpr uint32_t empty_slot = 0;
+
+    struct slot {
+        option<std::pair<K, V>> entry;
+        size_t hash{0};
+        bool referenced{false};
+    };
+
+    std::vector<slot> slots_;
+    // Slot number plus one of the entry at each position, or zero
+    std::vector<uint32_t> table_;
+    std::vector<uint32_t> free_;
+    size_t size_{0};
+    size_t used_{0};
+    size_t hand_{0};
+    JAC_NO_UNIQ_ADDR Hash hasher_;
+    JAC_NO_UNIQ_ADDR KeyEqual key_eq_;
+
+    size_t hash_key(const K& key) const {
+        return static_cast<size_t>(hash_mix(hasher_(key)));
+    }
+
+    size_t mask() const noexcept { return table_.size() - 1; }
+
+    // Finds the table position of `key`, or the empty position where it
+    // would be inserted
+    size_t probe(const K& key, size_t hash) const {
+        auto pos = hash & mask();
+        while (table_[pos] != empty_slot) {
+            auto& s = slots_[table_[pos] - 1];
+            if (s.hash == hash && key_eq_(s.entry->first, key)) { break; }
+            pos = (pos + 1) & mask();
+        }
+        return pos;
+    }
+
+    option<slot&> find_slot(const K& key) {
+        auto pos = probe(key, hash_key(key));
+        if (table_[pos] == empty_slot) { return null; }
+        return slots_[table_[pos] - 1];
+    }
+
+    // Removes a table entry, shifting later entries of the same probe run
+    // back so that no tombstones are needed
+    void unindex(size_t pos) noexcept {
+        for (auto next = (pos + 1) & mask(); table_[next] != empty_slot;
+             next = (next + 1) & mask()) {
+            auto home = slots_[table_[next] - 1].hash & mask();
+            // Move the entry back unless its home lies in (pos, next]
+            auto dist_home = (next - home) & mask();
+            auto dist_pos = (next - pos) & mask();
+            if (dist_home >= dist_pos) {
+                table_[pos] = table_[next];
+                pos = next;
+            }
+        }
+        table_[pos] = empty_slot;
+    }
+
+    uint32_t take_slot() {
+        if (!free_.empty()) {
+            auto idx = free_.back();
+            free_.pop_back();
+            return idx;
+        }
+        if (used_ < slots_.size()) { return static_cast<uint32_t>(used_++); }
+
+        // Every slot is occupied, so the sweep always finds a victim
+        while (slots_[hand_].referenced) {
+            slots_[hand_].referenced = false;
+            hand_ = (hand_ + 1) % slots_.size();
+        }
+        auto idx = static_cast<uint32_t>(hand_);
+        hand_ = (hand_ + 1) % slots_.size();
+        auto& victim = slots_[idx];
+        unindex(probe(victim.entry->first, victim.hash));
+        victim.entry.reset();
+        --size_;
+        return idx;
+    }
+
+    template <typename U>
+    V& add(const K& key, size_t hash, U&& value) {
+        auto idx = take_slot();
+        auto& s = slots_[idx];
+        try {
+            s.entry.emplace(key, std::forward<U>(value));
+            s.hash = hash;
+            s.referenced = false;
+            table_[probe(key, hash)] = idx + 1;
+        } catch (...) {
+            // The slot is empty again, so it must not be left to the sweep
+            s.entry.reset();
+            free_.push_back(idx);
+            throw;
+        }
+        ++size_;
+        return s.entry->second;
+    }
+
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using size_type = size_t;
+
+    /// @brief Creates a cache that holds up to `capacity` entries
+    ///
+    /// @throws std::invalid_argument if `capacity` is zero or does not fit in
+    /// 32 bits
+    explicit clock_cache(size_type capacity,
+                         const Hash& hash = Hash(),
+                         const KeyEqual& equal = KeyEqual())
+        : hasher_(hash), key_eq_(equal) {
+        if (capacity == 0 || capacity >= UINT32_MAX) {
+            throw std::invalid_argument("invalid jac::clock_cache capacity");
+        }
+        slots_.resize(capacity);
+        // Freeing a slot then never allocates, even while handling an
+        // exception
+        free_.reserve(capacity);
+        // At most half full, so probe runs stay short
+        table_.resize(std::bit_ceil(capacity * 2), empty_slot);
+    }
+
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    size_type capacity() const noexcept { return slots_.size(); }
+
+    hasher hash_function() const { return hasher_; }
+
+    /// @brief Looks up an entry and marks it as recently used
+    option<V&> get(const K& key) {
+        auto s = find_slot(key);
+        if (!s) { return null; }
+        s->referenced = true;
+        return s->entry->second;
+    }
+
+    /// @brief Looks up an entry without marking it as used
+    option<const V&> peek(const K& key) const {
+        auto pos = probe(key, hash_key(key));
+        if (table_[pos] == empty_slot) { return null; }
+        return slots_[table_[pos] - 1].entry->second;
+    }
+
+    bool contains(const K& key) const { return peek(key).has_value(); }
+
+    /// @brief Inserts or replaces an entry, evicting another if the cache is
+    /// full
+    template <typename U>
+    V& put(const K& key, U&& value) {
+        auto hash = hash_key(key);
+        auto pos = probe(key, hash);
+        if (table_[pos] != empty_slot) {
+            auto& s = slots_[table_[pos] - 1];
+            s.entry->second = std::forward<U>(value);
+            s.referenced = true;
+            return s.entry->second;
+        }
+        return add(key, hash, std::forward<U>(value));
+    }
+
+    /// @brief Gets an entry, or creates it with `make` if it is missing
+    ///
+    /// @details
+    /// `make` is called without arguments and returns a `result<V, E>`. If it
+    /// returns an error, nothing is inserted and the error is returned.
+    template <typename F>
+    auto try_get_or_insert(const K& key, F&& make)
+        -> result<V&, typename std::invoke_result_t<F>::error_type> {
+        using ret = result<V&, typename std::invoke_result_t<F>::error_type>;
+        if (auto value = get(key)) { return ret(std::in_place, *value); }
+        auto made = std::invoke(std::forward<F>(make));
+        if (!made.has_value()) {
+            return ret(in_place_error, std::move(made).error());
+        }
+        return ret(std::in_place, add(key, hash_key(key), *std::move(made)));
+    }
+
+    /// @brief Removes an entry
+    ///
+    /// @return The value of the removed entry, if there was one
+    option<V> erase(const K& key) {
+        auto pos = probe(key, hash_key(key));
+        if (table_[pos] == empty_slot) { return null; }
+        auto idx = table_[pos] - 1;
+        auto& s = slots_[idx];
+        option<V> value(std::move(s.entry->second));
+        unindex(pos);
+        s.entry.reset();
+        s.referenced = false;
+        free_.push_back(idx);
+        --size_;
+        return value;
+    }
+
+    void clear() noexcept {
+        for (auto& s : slots_) {
+            s.entry.reset();
+            s.referenced = false;
+        }
+        std::fill(table_.begin(), table_.end(), empty_slot);
+        free_.clear();
+        size_ = 0;
+        used_ = 0;
+        hand_ = 0;
+    }
+};
+
+} // namespace jac
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef JAC_COLLECT_HPP
+#define JAC_COLLECT_HPP
+
+/// @file
+
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <jac/result.hpp>
+
+namespace jac {
+
+namespace detail {
+
+template <typename R>
+concept result_range =
+    std::ranges::input_range<R> &&
+    is_result_v<std::remove_cvref_t<std::ranges::range_reference_t<R>>>;
+
+template <typename R>
+using range_result_t = std::remove_cvref_t<std::ranges::range_reference_t<R>>;
+
+template <typename Container, typename R>
+constexpr void collect_reserve(Container& out, R& r) {
+    if constexpr (std::ranges::sized_range<R> &&
+                  requires { out.reserve(std::ranges::size(r)); }) {
+        out.reserve(std::ranges::size(r));
+    }
+}
+
+template <typename Container, typename V>
+constexpr void collect_insert(Container& out, V&& value) {
+    if constexpr (requires { out.emplace_back(std::forward<V>(value)); }) {
+        out.emplace_back(std::forward<V>(value));
+    } else {
+        out.emplace(std::forward<V>(value));
+    }
+}
+
+// Moves the elements out of a container passed as an rvalue, which is
+// dropped afterwards, and copies them out of anything else
+template <typename R>
+inline constexpr bool collect_moves_v =
+    !std::is_lvalue_reference_v<R> && !std::ranges::borrowed_range<R> &&
+    !std::ranges::view<std::remove_cvref_t<R>>;
+
+template <typename R, typename It>
+constexpr decltype(auto) collect_element(It& it) {
+    if constexpr (collect_moves_v<R>) {
+        return std::ranges::iter_move(it);
+    } else {
+        return *it;
+    }
+}
+
+} // namespace detail
+
+/// @brief Collects the values of a range of results into `Container`, or
+/// returns the first error
+///
+/// @details
+/// The range is traversed once, stopping at the first error, and each value
+/// is moved or copied straight into the container, without an intermediate
+/// container of results. The container is reserved up front when the range
+/// is sized. Values are moved out of a container passed as an rvalue and of
+/// ranges that produce temporaries, and copied otherwise.
+///
+/// Values are appended with `emplace_back` when the container has it, and
+/// inserted with `emplace` otherwise, so sets and maps can be collected too.
+/// ```
+/// auto decoded = frames | std::views::transform(decode);
+/// jac::result<std::vector<message>, decode_error> batch =
+///     jac::collect<std::vector>(decoded);
+/// ```
+template <typename Container, typename R>
+    requires detail::result_range<R>
+constexpr result<Container, typename detail::range_result_t<R>::error_type>
+collect(R&& r) {
+    using out =
+        result<Container, typename detail::range_result_t<R>::error_type>;
+    Container values;
+    detail::collect_reserve(values, r);
+    auto last = std::ranges::end(r);
+    for (auto it = std::ranges::begin(r); it != last; ++it) {
+        decltype(auto) e = detail::collect_element<R>(it);
+        if (!e.has_value()) {
+            return out(in_place_error, std::forward<decltype(e)>(e).error());
+        }
+        detail::collect_insert(values, *std::forward<decltype(e)>(e));
+    }
+    return out(std::in_place, std::move(values));
+}
+
+/// @brief Collects the values of a range of results into a `Container` of the
+/// value type, or returns the first error
+///
+/// @details
+/// The same as `collect<Container<T>>(r)`, where `T` is the value type of
+/// the results.
+template <template <typename...> class Container, typename R>
+    requires detail::result_range<R>
+constexpr auto collect(R&& r) {
+    using value = typename detail::range_result_t<R>::value_type;
+    return collect<Container<value>>(std::forward<R>(r));
+}
+
+/// @brief Applies `f`, which returns a `result`, to each element of a range,
+/// collecting the values into a `Container`, or returns the first error
+///
+/// @details
+/// Equivalent to `collect<Container>(r | std::views::transform(f))`. Each
+/// result returned by `f` is checked and its value moved into the container
+/// before `f` is called on the next element, and no element after the first
+/// error is passed to `f`.
+/// ```
+/// auto parsed = jac::try_transform(lines, parse_record);
+/// if (!parsed.has_value()) { report(parsed.error()); }
+/// ```
+template <template <typename...> class Container = std::vector,
+          std::ranges::input_range R,
+          typename F>
+    requires detail::is_result_v<std::remove_cvref_t<
+        std::invoke_result_t<F&, std::ranges::range_reference_t<R>>>>
+constexpr auto try_transform(R&& r, F f) {
+    using fn_result = std::remove_cvref_t<
+        std::invoke_result_t<F&, std::ranges::range_reference_t<R>>>;
+    using container = Container<typename fn_result::value_type>;
+    using out = result<container, typename fn_result::error_type>;
+    container values;
+    detail::collect_reserve(values, r);
+    for (auto&& e : r) {
+        auto mapped = std::invoke(f, std::forward<decltype(e)>(e));
+        if (!mapped.has_value()) {
+            return out(in_place_error, std::move(mapped).error());
+        }
+        detail::collect_insert(values, *std::move(mapped));
+    }
+    return out(std::in_place, std::move(values));
+}
+
+} // namespace jac
+
+#endif
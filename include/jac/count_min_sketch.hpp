@@ -0,0 +1,191 @@
+#ifndef JAC_COUNT_MIN_SKETCH_HPP
+#define JAC_COUNT_MIN_SKETCH_HPP
+
+/// @file
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <jac/macros.hpp>
+#include <jac/option.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+/// @brief Estimates how often each key occurs in a stream in fixed memory
+///
+/// @details
+/// `count_min_sketch` keeps `depth` rows of `width` counters. Each key is
+/// hashed to one counter per row, and its estimated frequency is the smallest
+/// of those counters. Estimates never undercount, and with `width = e / eps`
+/// and `depth = ln(1 / delta)` they overcount by more than `eps` times the
+/// total count with probability at most `delta`.
+///
+/// Counts are added with conservative update: only the counters that are
+/// below the key's new estimate are raised, which greatly reduces the
+/// overcount for skewed streams compared to incrementing every row.
+///
+/// Sketches with the same dimensions can be merged, e.g. to combine
+/// per-thread sketches, and serialized to a compact byte string. Keys are
+/// hashed with `Hash`, so `option` and `result` keys work out of the box
+/// through their `std::hash` specializations.
+template <typename T, typename Hash = std::hash<T>>
+class count_min_sketch {
+  private:
+    uint32_t width_;
+    uint32_t depth_;
+    uint64_t total_{0};
+    // Row-major, `depth_` rows of `width_` counters
+    std::vector<uint64_t> counters_;
+    JAC_NO_UNIQ_ADDR Hash hasher_;
+
+    uint64_t hash(const T& key) const { return hash_mix(hasher_(key)); }
+
+    // The counter of each row is derived from the two halves of one hash
+    // (Kirsch-Mitzenmacher), so each key is hashed only once.
+    size_t counter(uint64_t h, uint32_t row) const noexcept {
+        auto h1 = static_cast<uint32_t>(h);
+        auto h2 = static_cast<uint32_t>(h >> 32) | 1;
+        auto g = h1 + row * h2;
+        return static_cast<size_t>(row) * width_ +
+               static_cast<size_t>((static_cast<uint64_t>(g) * width_) >> 32);
+    }
+
+  public:
+    using key_type = T;
+    using hasher = Hash;
+    using size_type = size_t;
+    using count_type = uint64_t;
+
+    /// @brief Creates a sketch of `depth` rows of `width` counters
+    ///
+    /// @throws std::invalid_argument if either dimension is zero
+    count_min_sketch(uint32_t width, uint32_t depth, const Hash& hash = Hash())
+        : width_(width), depth_(depth), hasher_(hash) {
+        if (width == 0 || depth == 0) {
+            throw std::invalid_argument("invalid jac::count_min_sketch size");
+        }
+        counters_.resize(static_cast<size_t>(width) * depth);
+    }
+
+    /// @brief Creates a sketch whose estimates exceed the true count by more
+    /// than `epsilon` times the total count with probability at most `delta`
+    ///
+    /// @throws std::invalid_argument if `epsilon` or `delta` is not in
+    /// (0, 1), or if `epsilon` is so small that the width overflows
+    static count_min_sketch with_error(double epsilon,
+                                       double delta,
+                                       const Hash& hash = Hash()) {
+        if (!(epsilon > 0 && epsilon < 1 && delta > 0 && delta < 1) ||
+            std::ceil(std::exp(1.0) / epsilon) >
+                std::numeric_limits<uint32_t>::max()) {
+            throw std::invalid_argument(
+                "invalid jac::count_min_sketch error bounds");
+        }
+        auto width = static_cast<uint32_t>(std::ceil(std::exp(1.0) / epsilon));
+        auto depth = static_cast<uint32_t>(std::ceil(std::log(1.0 / delta)));
+        return count_min_sketch(width, std::max<uint32_t>(depth, 1), hash);
+    }
+
+    uint32_t width() const noexcept { return width_; }
+
+    uint32_t depth() const noexcept { return depth_; }
+
+    /// @brief Sum of all counts added
+    count_type total() const noexcept { return total_; }
+
+    /// @brief Memory used by the counters, in bytes
+    size_type size_in_bytes() const noexcept {
+        return counters_.size() * sizeof(count_type);
+    }
+
+    void clear() noexcept {
+        std::fill(counters_.begin(), counters_.end(), 0);
+        total_ = 0;
+    }
+
+    /// @brief Adds `count` occurrences of `key`
+    void add(const T& key, count_type count = 1) {
+        auto h = hash(key);
+        count_type est = std::numeric_limits<count_type>::max();
+        for (uint32_t row = 0; row < depth_; ++row) {
+            est = std::min(est, counters_[counter(h, row)]);
+        }
+        auto target = est + count;
+        for (uint32_t row = 0; row < depth_; ++row) {
+            auto& c = counters_[counter(h, row)];
+            c = std::max(c, target);
+        }
+        total_ += count;
+    }
+
+    /// @brief Estimates the number of occurrences of `key`
+    count_type estimate(const T& key) const {
+        auto h = hash(key);
+        count_type est = std::numeric_limits<count_type>::max();
+        for (uint32_t row = 0; row < depth_; ++row) {
+            est = std::min(est, counters_[counter(h, row)]);
+        }
+        return est;
+    }
+
+    /// @brief Adds the counts of another sketch to this one
+    ///
+    /// @throws std::invalid_argument if the dimensions differ
+    void merge(const count_min_sketch& other) {
+        if (other.width_ != width_ || other.depth_ != depth_) {
+            throw std::invalid_argument(
+                "merging jac::count_min_sketch sketches of different size");
+        }
+        auto dst = counters_.data();
+        auto src = other.counters_.data();
+        for (size_type i = 0; i < counters_.size(); ++i) { dst[i] += src[i]; }
+        total_ += other.total_;
+    }
+
+    /// @brief Encodes the sketch as a byte string independent of the host's
+    /// endianness
+    std::vector<std::byte> serialize() const {
+        std::vector<std::byte> out;
+        out.reserve(16 + size_in_bytes());
+        detail::store_le(out, width_);
+        detail::store_le(out, depth_);
+        detail::store_le(out, total_);
+        for (auto c : counters_) { detail::store_le(out, c); }
+        return out;
+    }
+
+    /// @brief Decodes a sketch produced by `serialize`
+    ///
+    /// @return The sketch, or `null` if `bytes` is not a valid encoding
+    static option<count_min_sketch> deserialize(
+        std::span<const std::byte> bytes,
+        const Hash& hash = Hash()) {
+        if (bytes.size() < 16) { return null; }
+        auto width = detail::load_le<uint32_t>(bytes);
+        auto depth = detail::load_le<uint32_t>(bytes);
+        auto total = detail::load_le<uint64_t>(bytes);
+        if (width == 0 || depth == 0 ||
+            bytes.size() / sizeof(count_type) !=
+                static_cast<uint64_t>(width) * depth ||
+            bytes.size() % sizeof(count_type) != 0) {
+            return null;
+        }
+
+        count_min_sketch cms(width, depth, hash);
+        cms.total_ = total;
+        for (auto& c : cms.counters_) { c = detail::load_le<uint64_t>(bytes); }
+        return cms;
+    }
+};
+
+} // namespace jac
+
+#endif
@@ -0,0 +1,258 @@
+#ifndef JAC_COW_HPP
+#define JAC_COW_HPP
+
+/// @file
+
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include <jac/holder.hpp>
+#include <jac/macros.hpp>
+#include <jac/relocate.hpp>
+
+namespace jac {
+
+/// @brief A reference count that can be shared between threads
+///
+/// @details
+/// Copies of a `cow` that use this policy can be read, copied and destroyed
+/// concurrently from different threads, as with `std::shared_ptr`.
+class atomic_refcount {
+  private:
+    std::atomic<size_t> count_{1};
+
+  public:
+    void increment() noexcept {
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Decrements the count, returning `true` if it reached zero
+    bool decrement() noexcept {
+        if (count_.fetch_sub(1, std::memory_order_release) == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return true;
+        }
+        return false;
+    }
+
+    size_t count() const noexcept {
+        return count_.load(std::memory_order_acquire);
+    }
+};
+
+/// @brief A reference count for values that never leave one thread
+///
+/// @details
+/// Copying and destroying a `cow` that uses this policy costs a plain
+/// increment or decrement instead of an atomic read-modify-write.
+class local_refcount {
+  private:
+    size_t count_{1};
+
+  public:
+    void increment() noexcept { ++count_; }
+
+    /// @brief Decrements the count, returning `true` if it reached zero
+    bool decrement() noexcept { return --count_ == 0; }
+
+    size_t count() const noexcept { return count_; }
+};
+
+/// @brief A value whose copies share one allocation until one of them is
+/// modified
+///
+/// @details
+/// Copying a `cow` only increments a reference count, so large values can be
+/// passed by value through many layers without being copied. The value is
+/// copied by the first mutable access to a `cow` whose allocation is shared,
+/// which includes the non-const overloads of `operator*`, `operator->`,
+/// `value()` and `as_ref()`. Read through a const `cow`, for example with
+/// `std::as_const`, to avoid that copy.
+///
+/// `Refcount` is `atomic_refcount` by default, which makes it safe to use
+/// copies of the same `cow` from different threads. `local_refcount` avoids
+/// atomic operations when every copy stays on one thread.
+///
+/// A moved-from `cow` holds no value and may only be assigned to or
+/// destroyed.
+/// ```
+/// jac::cow<schema> s = load_schema();
+/// auto copy = s;               // No copy of the schema
+/// copy->tables.push_back(t);   // Copies the schema, leaving `s` unchanged
+/// ```
+template <typename T, typename Refcount = atomic_refcount>
+class cow {
+  private:
+    static_assert(std::is_object_v<T> && !std::is_array_v<T> &&
+                      !std::is_const_v<T>,
+                  "jac::cow needs a non-const, non-array object type");
+
+    struct block {
+        JAC_NO_UNIQ_ADDR Refcount count;
+        T value;
+
+        template <typename... Args>
+        explicit block([[maybe_unused]] std::in_place_t in_place,
+                       Args&&... args)
+            : value(std::forward<Args>(args)...) {}
+    };
+
+    block* block_;
+
+    template <typename... Args>
+    static block* make(Args&&... args) {
+        return new block(std::in_place, std::forward<Args>(args)...);
+    }
+
+    void release() noexcept {
+        if (block_ != nullptr && block_->count.decrement()) { delete block_; }
+    }
+
+  public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using rvalue_reference = T&&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using refcount_type = Refcount;
+
+    cow() : block_(make()) {}
+
+    template <typename... Args>
+    explicit(sizeof...(Args) == 0)
+        cow([[maybe_unused]] std::in_place_t in_place, Args&&... args)
+        : block_(make(std::forward<Args>(args)...)) {}
+
+    template <typename U, typename... Args>
+    cow([[maybe_unused]] std::in_place_t in_place,
+        std::initializer_list<U> ilist,
+        Args&&... args)
+        : block_(make(ilist, std::forward<Args>(args)...)) {}
+
+    template <typename U = T>
+        requires(std::is_constructible_v<T, U &&> &&
+                 !std::is_same_v<std::remove_cvref_t<U>, std::in_place_t> &&
+                 !std::is_same_v<std::remove_cvref_t<U>, cow>)
+    explicit(!std::is_convertible_v<U&&, T>) cow(U&& value)
+        : block_(make(std::forward<U>(value))) {}
+
+    cow(const cow& other) noexcept : block_(other.block_) {
+        block_->count.increment();
+    }
+
+    cow(cow&& other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+
+    ~cow() { release(); }
+
+    cow& operator=(const cow& other) noexcept {
+        other.block_->count.increment();
+        release();
+        block_ = other.block_;
+        return *this;
+    }
+
+    cow& operator=(cow&& other) noexcept {
+        if (this != &other) {
+            release();
+            block_ = std::exchange(other.block_, nullptr);
+        }
+        return *this;
+    }
+
+    /// @brief Replaces the value, assigning in place if it is not shared
+    template <typename U = T>
+        requires(!std::is_same_v<std::remove_cvref_t<U>, cow> &&
+                 std::is_constructible_v<T, U> && std::is_assignable_v<T&, U>)
+    cow& operator=(U&& value) {
+        if (is_unique()) {
+            block_->value = std::forward<U>(value);
+        } else {
+            auto fresh = make(std::forward<U>(value));
+            release();
+            block_ = fresh;
+        }
+        return *this;
+    }
+
+    /// @brief The number of `cow` objects sharing the value
+    size_t use_count() const noexcept {
+        return block_ == nullptr ? 0 : block_->count.count();
+    }
+
+    /// @brief Checks if no other `cow` shares the value
+    bool is_unique() const noexcept { return use_count() == 1; }
+
+    /// @brief Copies the value if it is shared, so that it can be modified
+    /// without affecting other copies
+    void detach() {
+        if (block_->count.count() != 1) {
+            auto fresh = make(std::as_const(block_->value));
+            release();
+            block_ = fresh;
+        }
+    }
+
+    reference value() & {
+        detach();
+        return block_->value;
+    }
+
+    const_reference value() const& noexcept { return block_->value; }
+
+    rvalue_reference value() && {
+        detach();
+        return std::move(block_->value);
+    }
+
+    reference operator*() & { return value(); }
+
+    const_reference operator*() const& noexcept { return block_->value; }
+
+    rvalue_reference operator*() && { return std::move(*this).value(); }
+
+    pointer operator->() { return &value(); }
+
+    const_pointer operator->() const noexcept { return &block_->value; }
+
+    holder<reference> as_ref() & { return holder<reference>(value()); }
+
+    holder<const_reference> as_ref() const& noexcept {
+        return holder<const_reference>(block_->value);
+    }
+
+    void swap(cow& other) noexcept { std::swap(block_, other.block_); }
+
+    friend void swap(cow& lhs, cow& rhs) noexcept { lhs.swap(rhs); }
+
+    friend bool operator==(const cow& lhs, const cow& rhs) {
+        return lhs.block_ == rhs.block_ || *lhs == *rhs;
+    }
+
+    friend auto operator<=>(const cow& lhs, const cow& rhs) {
+        return *lhs <=> *rhs;
+    }
+};
+
+template <typename T, typename Refcount>
+struct is_trivially_relocatable<cow<T, Refcount>> : std::true_type {};
+
+} // namespace jac
+
+template <typename T, typename Refcount>
+struct std::hash<::jac::cow<T, Refcount>> {
+  private:
+    JAC_NO_UNIQ_ADDR std::hash<T> inner_;
+
+  public:
+    size_t operator()(const ::jac::cow<T, Refcount>& value) const {
+        return inner_(*value);
+    }
+};
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef JAC_CUCKOO_FILTER_HPP
+#define JAC_CUCKOO_FILTER_HPP
+
+/// @file
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <jac/macros.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+/// @brief An approximate membership filter that supports deletion
+///
+/// @details
+/// `cuckoo_filter` stores a 16-bit fingerprint of each key in one of two
+/// candidate buckets of four fingerprints. Each bucket is a single 64-bit
+/// word, so a query reads at most two words and compares all four
+/// fingerprints of a bucket at once with SWAR (SIMD within a register)
+/// arithmetic. The false positive rate is roughly 0.01% at high load.
+///
+/// Unlike a Bloom filter, a key that was inserted can be erased again. Only
+/// erase keys that were actually inserted, since erasing a key that merely
+/// collides with another one's fingerprint removes that other key.
+///
+/// Keys are hashed with `Hash`, and the result is scrambled with
+/// `jac::hash_mix`, so identity hashes such as `std::hash<int>` work well.
+template <typename T, typename Hash = std::hash<T>>
+class cuckoo_filter {
+  private:
+    static constexpr size_t slots = 4;
+    static constexpr size_t batch = 16;
+    static constexpr size_t max_kicks = 500;
+    static constexpr uint64_t lane_ones = 0x0001000100010001;
+    static constexpr uint64_t lane_highs = 0x8000800080008000;
+
+    std::vector<uint64_t> buckets_;
+    uint64_t mask_;
+    size_t size_{0};
+    uint64_t rng_{0x9e3779b97f4a7c15};
+    // A fingerprint that could not be placed after the maximum number of
+    // kicks. Keeping it avoids false negatives once the filter is full.
+    uint16_t victim_fp_{0};
+    uint64_t victim_idx_{0};
+    JAC_NO_UNIQ_ADDR Hash hasher_;
+
+    struct location {
+        uint64_t i1;
+        uint64_t i2;
+        uint16_t fp;
+    };
+
+    location locate(const T& key) const {
+        auto h = hash_mix(hasher_(key));
+        // Zero marks an empty slot, so it is never used as a fingerprint
+        auto fp = static_cast<uint16_t>(h >> 48);
+        fp += static_cast<uint16_t>(fp == 0);
+        auto i1 = h & mask_;
+        return {i1, alt_index(i1, fp), fp};
+    }
+
+    uint64_t alt_index(uint64_t idx, uint16_t fp) const noexcept {
+        return (idx ^ hash_mix(fp)) & mask_;
+    }
+
+    static uint16_t lane(uint64_t bucket, size_t slot) noexcept {
+        return static_cast<uint16_t>(bucket >> (16 * slot));
+    }
+
+    // Finds the slot holding `fp` in a bucket, or `slots` if there is none
+    static size_t find_slot(uint64_t bucket, uint16_t fp) noexcept {
+        auto x = bucket ^ (lane_ones * fp);
+        auto zero_lanes = (x - lane_ones) & ~x & lane_highs;
+        return zero_lanes == 0
+                   ? slots
+                   : static_cast<size_t>(std::countr_zero(zero_lanes)) / 16;
+    }
+
+    bool try_put(uint64_t idx, uint16_t fp) noexcept {
+        auto slot = find_slot(buckets_[idx], 0);
+        if (slot == slots) { return false; }
+        buckets_[idx] |= static_cast<uint64_t>(fp) << (16 * slot);
+        return true;
+    }
+
+    bool test(const location& loc) const noexcept {
+        return find_slot(buckets_[loc.i1], loc.fp) != slots ||
+               find_slot(buckets_[loc.i2], loc.fp) != slots ||
+               (victim_fp_ == loc.fp &&
+                (victim_idx_ == loc.i1 || victim_idx_ == loc.i2));
+    }
+
+  public:
+    using key_type = T;
+    using hasher = Hash;
+    using size_type = size_t;
+
+    /// @brief Creates a filter with room for at least `capacity` keys
+    explicit cuckoo_filter(size_type capacity, const Hash& hash = Hash())
+        : buckets_(std::bit_ceil(std::max<size_type>(
+              (capacity * 100 / 95 + slots - 1) / slots, 1))),
+          mask_(buckets_.size() - 1),
+          hasher_(hash) {}
+
+    /// @brief Number of keys currently stored
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Checks if the filter has run out of room for new keys
+    bool full() const noexcept { return victim_fp_ != 0; }
+
+    /// @brief Size of the filter in bytes
+    size_type size_in_bytes() const noexcept {
+        return buckets_.size() * sizeof(uint64_t);
+    }
+
+    void clear() noexcept {
+        std::fill(buckets_.begin(), buckets_.end(), 0);
+        size_ = 0;
+        victim_fp_ = 0;
+    }
+
+    /// @brief Adds a key to the filter
+    ///
+    /// @return `false` if the filter is full and the key was not added
+    bool insert(const T& key) {
+        if (full()) { return false; }
+        auto loc = locate(key);
+        ++size_;
+        if (try_put(loc.i1, loc.fp) || try_put(loc.i2, loc.fp)) {
+            return true;
+        }
+
+        auto idx = (rng_ & 1) != 0 ? loc.i1 : loc.i2;
+        auto fp = loc.fp;
+        for (size_t kick = 0; kick < max_kicks; ++kick) {
+            rng_ = hash_mix(rng_);
+            auto slot = static_cast<size_t>(rng_ % slots);
+            auto shift = 16 * slot;
+            auto evicted = lane(buckets_[idx], slot);
+            buckets_[idx] = (buckets_[idx] & ~(uint64_t{0xffff} << shift)) |
+                            (static_cast<uint64_t>(fp) << shift);
+            fp = evicted;
+            idx = alt_index(idx, fp);
+            if (try_put(idx, fp)) { return true; }
+        }
+        victim_fp_ = fp;
+        victim_idx_ = idx;
+        return true;
+    }
+
+    /// @brief Removes a previously inserted key from the filter
+    ///
+    /// @return `false` if no matching fingerprint was found
+    bool erase(const T& key) {
+        auto loc = locate(key);
+        for (auto idx : {loc.i1, loc.i2}) {
+            auto slot = find_slot(buckets_[idx], loc.fp);
+            if (slot != slots) {
+                buckets_[idx] &= ~(uint64_t{0xffff} << (16 * slot));
+                --size_;
+                if (victim_fp_ != 0) {
+                    // Room was made, so try to place the victim again
+                    auto fp = std::exchange(victim_fp_, 0);
+                    if (!try_put(victim_idx_, fp) &&
+                        !try_put(alt_index(victim_idx_, fp), fp)) {
+                        victim_fp_ = fp;
+                    }
+                }
+                return true;
+            }
+        }
+        if (victim_fp_ == loc.fp &&
+            (victim_idx_ == loc.i1 || victim_idx_ == loc.i2)) {
+            victim_fp_ = 0;
+            --size_;
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Checks if a key may have been inserted
+    ///
+    /// @details
+    /// A `false` result means the key is definitely not in the filter.
+    bool may_contain(const T& key) const { return test(locate(key)); }
+
+    /// @brief Checks a batch of keys, writing each result to `out`
+    ///
+    /// @details
+    /// Keys are processed in groups whose candidate buckets are all prefetched
+    /// before any of them are tested, so the cache misses of a group overlap
+    /// instead of being serialized. `out` must be at least as long as `keys`.
+    ///
+    /// @return The number of keys that may have been inserted
+    size_type may_contain_n(std::span<const T> keys,
+                            std::span<bool> out) const {
+        size_type hits = 0;
+        location locs[batch];
+        for (size_type base = 0; base < keys.size(); base += batch) {
+            auto n = std::min(batch, keys.size() - base);
+            for (size_type i = 0; i < n; ++i) {
+                locs[i] = locate(keys[base + i]);
+                JAC_PREFETCH(&buckets_[locs[i].i1]);
+                JAC_PREFETCH(&buckets_[locs[i].i2]);
+            }
+            for (size_type i = 0; i < n; ++i) {
+                auto found = test(locs[i]);
+                out[base + i] = found;
+                hits += found;
+            }
+        }
+        return hits;
+    }
+};
+
+} // namespace jac
+
+#endif
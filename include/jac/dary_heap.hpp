@@ -0,0 +1,415 @@
+#ifndef JAC_DARY_HEAP_HPP
+#define JAC_DARY_HEAP_HPP
+
+/// @file
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <jac/macros.hpp>
+#include <jac/option.hpp>
+
+namespace jac {
+
+namespace detail {
+
+// The heap algorithms move a hole instead of swapping, and call `moved(i)`
+// whenever an element lands at index `i`, so that indexed heaps can track
+// positions
+
+template <size_t D, typename E, typename Less, typename Moved>
+size_t dary_sift_up(std::vector<E>& heap,
+                    size_t i,
+                    const Less& less,
+                    const Moved& moved) {
+    E value = std::move(heap[i]);
+    while (i > 0) {
+        auto parent = (i - 1) / D;
+        if (!less(value, heap[parent])) { break; }
+        heap[i] = std::move(heap[parent]);
+        moved(i);
+        i = parent;
+    }
+    heap[i] = std::move(value);
+    moved(i);
+    return i;
+}
+
+template <size_t D, typename E, typename Less, typename Moved>
+void dary_sift_down(std::vector<E>& heap,
+                    size_t i,
+                    const Less& less,
+                    const Moved& moved) {
+    auto size = heap.size();
+    E value = std::move(heap[i]);
+    while (true) {
+        auto first = D * i + 1;
+        if (first >= size) { break; }
+        auto last = first + D < size ? first + D : size;
+        auto best = first;
+        for (auto c = first + 1; c < last; ++c) {
+            if (less(heap[c], heap[best])) { best = c; }
+        }
+        if (!less(heap[best], value)) { break; }
+        heap[i] = std::move(heap[best]);
+        moved(i);
+        i = best;
+    }
+    heap[i] = std::move(value);
+    moved(i);
+}
+
+template <size_t D, typename E, typename Less, typename Moved>
+void dary_make_heap(std::vector<E>& heap,
+                    const Less& less,
+                    const Moved& moved) {
+    if (heap.size() < 2) {
+        for (size_t i = 0; i < heap.size(); ++i) { moved(i); }
+        return;
+    }
+    for (auto i = (heap.size() - 2) / D + 1; i-- > 0;) {
+        dary_sift_down<D>(heap, i, less, moved);
+    }
+}
+
+struct dary_no_moved {
+    constexpr void operator()([[maybe_unused]] size_t i) const noexcept {}
+};
+
+} // namespace detail
+
+/// @brief A priority queue stored as an implicit heap with `D` children per
+/// node
+///
+/// @details
+/// A wider heap is shallower, so a push moves an element across fewer
+/// levels, and the `D` children compared when sifting down are adjacent in
+/// memory. With the default arity of 4, the children of a node usually share
+/// a cache line, which makes `dary_heap` faster than a binary heap for most
+/// element types.
+///
+/// Unlike `std::priority_queue`, the top of the heap is the least element
+/// according to `Compare`, which is the order needed by shortest-path and
+/// scheduling algorithms. Use `std::greater<T>` for a max-heap.
+template <typename T, size_t D = 4, typename Compare = std::less<T>>
+class dary_heap {
+  private:
+    static_assert(D >= 2, "a jac::dary_heap needs at least 2 children");
+
+    std::vector<T> heap_;
+    JAC_NO_UNIQ_ADDR Compare less_;
+
+  public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using value_compare = Compare;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    static constexpr size_type arity = D;
+
+    dary_heap() = default;
+
+    explicit dary_heap(const Compare& compare) : less_(compare) {}
+
+    /// @brief Creates a heap from a range in O(n)
+    template <std::input_iterator It>
+    dary_heap(It first, It last, const Compare& compare = Compare())
+        : heap_(first, last), less_(compare) {
+        detail::dary_make_heap<D>(heap_, less_, detail::dary_no_moved());
+    }
+
+    dary_heap(std::initializer_list<T> ilist,
+              const Compare& compare = Compare())
+        : dary_heap(ilist.begin(), ilist.end(), compare) {}
+
+    size_type size() const noexcept { return heap_.size(); }
+
+    bool empty() const noexcept { return heap_.empty(); }
+
+    void reserve(size_type count) { heap_.reserve(count); }
+
+    /// @brief Iterates over the elements in heap order, which is unspecified
+    const_iterator begin() const noexcept { return heap_.begin(); }
+
+    const_iterator end() const noexcept { return heap_.end(); }
+
+    /// @brief Gets the least element
+    option<const T&> top() const noexcept {
+        return empty() ? option<const T&>() : option<const T&>(heap_.front());
+    }
+
+    void push(const T& value) { emplace(value); }
+
+    void push(T&& value) { emplace(std::move(value)); }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        heap_.emplace_back(std::forward<Args>(args)...);
+        detail::dary_sift_up<D>(heap_, heap_.size() - 1, less_,
+                                detail::dary_no_moved());
+    }
+
+    /// @brief Removes and returns the least element
+    option<T> pop() {
+        if (empty()) { return null; }
+        option<T> top(std::move(heap_.front()));
+        if (heap_.size() > 1) {
+            heap_.front() = std::move(heap_.back());
+            heap_.pop_back();
+            detail::dary_sift_down<D>(heap_, 0, less_,
+                                      detail::dary_no_moved());
+        } else {
+            heap_.pop_back();
+        }
+        return top;
+    }
+
+    void clear() noexcept { heap_.clear(); }
+
+    void swap(dary_heap& other) noexcept {
+        using std::swap;
+        swap(heap_, other.heap_);
+        swap(less_, other.less_);
+    }
+};
+
+template <typename T, size_t D, typename Compare>
+void swap(dary_heap<T, D, Compare>& lhs,
+          dary_heap<T, D, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/// @brief A `dary_heap` whose elements can be found, changed and removed
+/// through handles
+///
+/// @details
+/// Each pushed element gets a handle, and the heap keeps the position of
+/// every element up to date as it moves, so `decrease_key`, `update` and
+/// `erase` take O(log n) instead of requiring a search or a duplicate entry.
+/// Handles are checked with a generation count, so a handle to an element
+/// that was popped or erased refers to nothing, even if its storage has been
+/// reused.
+template <typename T, size_t D = 4, typename Compare = std::less<T>>
+class indexed_dary_heap {
+  private:
+    static_assert(D >= 2, "a jac::indexed_dary_heap needs at least 2 children");
+
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    struct entry {
+        T value;
+        uint32_t slot;
+    };
+
+    struct slot {
+        // Position in the heap, or npos if the slot is free
+        uint32_t pos{npos};
+        uint32_t generation{0};
+    };
+
+    struct entry_less {
+        JAC_NO_UNIQ_ADDR Compare less;
+
+        bool operator()(const entry& lhs, const entry& rhs) const {
+            return less(lhs.value, rhs.value);
+        }
+    };
+
+    std::vector<entry> heap_;
+    std::vector<slot> slots_;
+    std::vector<uint32_t> free_;
+    JAC_NO_UNIQ_ADDR entry_less less_;
+
+    auto moved() noexcept {
+        return [this](size_t i) {
+            slots_[heap_[i].slot].pos = static_cast<uint32_t>(i);
+        };
+    }
+
+    void sift(size_t i) {
+        if (detail::dary_sift_up<D>(heap_, i, less_, moved()) == i) {
+            detail::dary_sift_down<D>(heap_, i, less_, moved());
+        }
+    }
+
+    // Removes the element at position `i` and frees its slot
+    T remove_at(size_t i) {
+        free_.push_back(heap_[i].slot);
+        auto& s = slots_[heap_[i].slot];
+        s.pos = npos;
+        ++s.generation;
+        T value = std::move(heap_[i].value);
+        if (i + 1 < heap_.size()) {
+            heap_[i] = std::move(heap_.back());
+            heap_.pop_back();
+            sift(i);
+        } else {
+            heap_.pop_back();
+        }
+        return value;
+    }
+
+  public:
+    using value_type = T;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using value_compare = Compare;
+
+    static constexpr size_type arity = D;
+
+    /// @brief Identifies an element of an `indexed_dary_heap`
+    class handle {
+      private:
+        friend class indexed_dary_heap;
+
+        uint32_t slot_{npos};
+        uint32_t generation_{0};
+
+        constexpr handle(uint32_t slot, uint32_t generation) noexcept
+            : slot_(slot), generation_(generation) {}
+
+      public:
+        /// @brief Creates a handle that refers to no element
+        constexpr handle() noexcept = default;
+
+        friend constexpr bool operator==(const handle& lhs,
+                                         const handle& rhs) noexcept = default;
+    };
+
+    indexed_dary_heap() = default;
+
+    explicit indexed_dary_heap(const Compare& compare)
+        : less_(entry_less{compare}) {}
+
+    size_type size() const noexcept { return heap_.size(); }
+
+    bool empty() const noexcept { return heap_.empty(); }
+
+    void reserve(size_type count) {
+        heap_.reserve(count);
+        slots_.reserve(count);
+    }
+
+    /// @brief Checks if `h` refers to an element of the heap
+    bool contains(handle h) const noexcept {
+        return h.slot_ < slots_.size() &&
+               slots_[h.slot_].generation == h.generation_ &&
+               slots_[h.slot_].pos != npos;
+    }
+
+    /// @brief Gets the element referred to by `h`
+    option<const T&> get(handle h) const noexcept {
+        if (!contains(h)) { return null; }
+        return heap_[slots_[h.slot_].pos].value;
+    }
+
+    /// @brief Gets the least element
+    option<const T&> top() const noexcept {
+        if (empty()) { return null; }
+        return heap_.front().value;
+    }
+
+    /// @brief Gets the handle of the least element
+    option<handle> top_handle() const noexcept {
+        if (empty()) { return null; }
+        auto idx = heap_.front().slot;
+        return handle(idx, slots_[idx].generation);
+    }
+
+    /// @brief Adds an element
+    ///
+    /// @throws std::length_error if the heap already holds 2<sup>32</sup> - 1
+    /// elements
+    template <typename... Args>
+    handle emplace(Args&&... args) {
+        uint32_t idx;
+        if (!free_.empty()) {
+            idx = free_.back();
+        } else {
+            if (slots_.size() >= npos) {
+                throw std::length_error("too many jac::indexed_dary_heap "
+                                        "elements");
+            }
+            idx = static_cast<uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        heap_.push_back(entry{T(std::forward<Args>(args)...), idx});
+        if (!free_.empty()) { free_.pop_back(); }
+        detail::dary_sift_up<D>(heap_, heap_.size() - 1, less_, moved());
+        return handle(idx, slots_[idx].generation);
+    }
+
+    handle push(const T& value) { return emplace(value); }
+
+    handle push(T&& value) { return emplace(std::move(value)); }
+
+    /// @brief Removes and returns the least element
+    option<T> pop() {
+        if (empty()) { return null; }
+        return remove_at(0);
+    }
+
+    /// @brief Removes the element referred to by `h`
+    ///
+    /// @return The removed element, or null if `h` does not refer to an
+    /// element of the heap
+    option<T> erase(handle h) {
+        if (!contains(h)) { return null; }
+        return remove_at(slots_[h.slot_].pos);
+    }
+
+    /// @brief Replaces the element referred to by `h` with one that does not
+    /// compare greater than it
+    ///
+    /// @return `false` if `h` does not refer to an element of the heap
+    ///
+    /// @throws std::invalid_argument if `value` compares greater than the
+    /// current element
+    bool decrease_key(handle h, T value) {
+        if (!contains(h)) { return false; }
+        auto pos = slots_[h.slot_].pos;
+        if (less_.less(heap_[pos].value, value)) {
+            throw std::invalid_argument(
+                "jac::indexed_dary_heap::decrease_key would increase the key");
+        }
+        heap_[pos].value = std::move(value);
+        detail::dary_sift_up<D>(heap_, pos, less_, moved());
+        return true;
+    }
+
+    /// @brief Replaces the element referred to by `h`, moving it up or down
+    /// as needed
+    ///
+    /// @return `false` if `h` does not refer to an element of the heap
+    bool update(handle h, T value) {
+        if (!contains(h)) { return false; }
+        auto pos = slots_[h.slot_].pos;
+        heap_[pos].value = std::move(value);
+        sift(pos);
+        return true;
+    }
+
+    /// @brief Removes every element, invalidating every handle
+    void clear() {
+        free_.reserve(slots_.size());
+        for (auto& e : heap_) {
+            auto& s = slots_[e.slot];
+            s.pos = npos;
+            ++s.generation;
+            free_.push_back(e.slot);
+        }
+        heap_.clear();
+    }
+};
+
+} // namespace jac
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef JAC_FUNCTION_HPP
+#define JAC_FUNCTION_HPP
+
+/// @file
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <jac/relocate.hpp>
+
+namespace jac {
+
+namespace detail {
+
+enum class function_op { relocate, destroy };
+
+inline constexpr size_t default_function_capacity = 4 * sizeof(void*);
+
+template <typename R, typename F, typename... Args>
+R invoke_r(F& f, Args&&... args) {
+    if constexpr (std::is_void_v<R>) {
+        std::invoke(f, std::forward<Args>(args)...);
+    } else {
+        return std::invoke(f, std::forward<Args>(args)...);
+    }
+}
+
+template <typename Sig, size_t Capacity, bool Spill>
+class basic_function;
+
+template <typename R, typename... Args, size_t Capacity, bool Spill>
+class basic_function<R(Args...), Capacity, Spill> {
+  private:
+    static_assert(Capacity >= sizeof(void*),
+                  "a jac::function buffer must hold at least a pointer");
+
+    using invoker = R (*)(std::byte*, Args&&...);
+    using manager = void (*)(function_op, std::byte*, std::byte*) noexcept;
+
+    template <typename F>
+    static constexpr bool fits_inline =
+        sizeof(F) <= Capacity && alignof(F) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<F>;
+
+    alignas(std::max_align_t) std::byte storage_[Capacity];
+    // Points to `invoke_empty` rather than being null, so that calls need no
+    // branch
+    invoker invoke_{&invoke_empty};
+    // Null when the stored callable can be moved by copying its bytes and
+    // needs no destruction
+    manager manage_{nullptr};
+
+    [[noreturn]] static R invoke_empty([[maybe_unused]] std::byte* storage,
+                                       [[maybe_unused]] Args&&... args) {
+        throw std::bad_function_call();
+    }
+
+    template <typename F>
+    static R invoke_inline(std::byte* storage, Args&&... args) {
+        return invoke_r<R>(*std::launder(reinterpret_cast<F*>(storage)),
+                           std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    static void manage_inline(function_op op,
+                              std::byte* src,
+                              std::byte* dst) noexcept {
+        auto f = std::launder(reinterpret_cast<F*>(src));
+        if (op == function_op::relocate) {
+            relocate(f, reinterpret_cast<F*>(dst));
+        } else {
+            std::destroy_at(f);
+        }
+    }
+
+    template <typename F>
+    static F*& heap_ptr(std::byte* storage) noexcept {
+        return *std::launder(reinterpret_cast<F**>(storage));
+    }
+
+    template <typename F>
+    static R invoke_heap(std::byte* storage, Args&&... args) {
+        return invoke_r<R>(*heap_ptr<F>(storage), std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    static void manage_heap(function_op op,
+                            std::byte* src,
+                            std::byte* dst) noexcept {
+        if (op == function_op::relocate) {
+            ::new (static_cast<void*>(dst)) F*(heap_ptr<F>(src));
+        } else {
+            delete heap_ptr<F>(src);
+        }
+    }
+
+    template <typename F>
+    static bool is_null(const F& f) noexcept {
+        if constexpr (std::is_pointer_v<F> || std::is_member_pointer_v<F>) {
+            return f == nullptr;
+        } else {
+            return false;
+        }
+    }
+
+    void steal(basic_function& other) noexcept {
+        if (other.manage_ != nullptr) {
+            other.manage_(function_op::relocate, other.storage_, storage_);
+        } else {
+            std::memcpy(storage_, other.storage_, Capacity);
+        }
+        invoke_ = std::exchange(other.invoke_, &invoke_empty);
+        manage_ = std::exchange(other.manage_, nullptr);
+    }
+
+  public:
+    using result_type = R;
+
+    /// @brief The size of the inline buffer
+    static constexpr size_t capacity = Capacity;
+
+    /// @brief Checks if a callable of type `F` is stored without allocating
+    template <typename F>
+    static constexpr bool is_inline = fits_inline<std::decay_t<F>>;
+
+    basic_function() noexcept = default;
+
+    basic_function([[maybe_unused]] std::nullptr_t null) noexcept {}
+
+    /// @brief Stores a callable
+    ///
+    /// @details
+    /// A null function or member pointer results in an empty function.
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, basic_function> &&
+                 std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    basic_function(F&& f) {
+        using D = std::decay_t<F>;
+        static_assert(Spill || sizeof(D) <= Capacity,
+                      "callable is too large for this jac::inplace_function");
+        static_assert(Spill || alignof(D) <= alignof(std::max_align_t),
+                      "callable is overaligned for jac::inplace_function");
+        static_assert(Spill || std::is_nothrow_move_constructible_v<D>,
+                      "jac::inplace_function needs a callable that is nothrow "
+                      "move constructible");
+        if (is_null(f)) { return; }
+        if constexpr (fits_inline<D>) {
+            ::new (static_cast<void*>(storage_)) D(std::forward<F>(f));
+            invoke_ = &invoke_inline<D>;
+            if constexpr (!is_trivially_relocatable_v<D> ||
+                          !std::is_trivially_destructible_v<D>) {
+                manage_ = &manage_inline<D>;
+            }
+        } else {
+            ::new (static_cast<void*>(storage_)) D*(new D(std::forward<F>(f)));
+            invoke_ = &invoke_heap<D>;
+            manage_ = &manage_heap<D>;
+        }
+    }
+
+    basic_function(const basic_function&) = delete;
+
+    basic_function(basic_function&& other) noexcept { steal(other); }
+
+    ~basic_function() {
+        if (manage_ != nullptr) {
+            manage_(function_op::destroy, storage_, nullptr);
+        }
+    }
+
+    basic_function& operator=(const basic_function&) = delete;
+
+    basic_function& operator=(basic_function&& other) noexcept {
+        if (this != &other) {
+            reset();
+            steal(other);
+        }
+        return *this;
+    }
+
+    basic_function& operator=([[maybe_unused]] std::nullptr_t null) noexcept {
+        reset();
+        return *this;
+    }
+
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, basic_function> &&
+                 std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    basic_function& operator=(F&& f) {
+        basic_function tmp(std::forward<F>(f));
+        reset();
+        steal(tmp);
+        return *this;
+    }
+
+    /// @brief Destroys the stored callable, leaving the function empty
+    void reset() noexcept {
+        if (manage_ != nullptr) {
+            manage_(function_op::destroy, storage_, nullptr);
+        }
+        invoke_ = &invoke_empty;
+        manage_ = nullptr;
+    }
+
+    explicit operator bool() const noexcept { return invoke_ != &invoke_empty; }
+
+    /// @brief Calls the stored callable
+    ///
+    /// @throws std::bad_function_call if the function is empty
+    R operator()(Args... args) const {
+        return invoke_(const_cast<std::byte*>(storage_),
+                       std::forward<Args>(args)...);
+    }
+
+    void swap(basic_function& other) noexcept {
+        basic_function tmp(std::move(other));
+        other.steal(*this);
+        steal(tmp);
+    }
+
+    friend void swap(basic_function& lhs, basic_function& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const basic_function& f,
+                           [[maybe_unused]] std::nullptr_t null) noexcept {
+        return !f;
+    }
+};
+
+} // namespace detail
+
+/// @brief A move-only function wrapper that stores its callable inline and
+/// never allocates
+///
+/// @details
+/// The callable is stored in a buffer of `Capacity` bytes inside the
+/// `inplace_function`, and calling it is a single indirect call through a
+/// function pointer. Storing a callable that is larger than the buffer,
+/// overaligned, or not nothrow move constructible fails to compile, so
+/// `inplace_function` can be used where allocation is not allowed.
+///
+/// Moving an `inplace_function` relocates the callable, which is a plain
+/// copy of the buffer when the callable is trivially relocatable. Like
+/// `std::function`, calling it calls the callable as non-const, and calling
+/// an empty one throws `std::bad_function_call`.
+/// ```
+/// jac::inplace_function<void(int), 64> on_event =
+///     [buf = big_buffer{}](int e) { ... };
+/// ```
+template <typename Sig, size_t Capacity = detail::default_function_capacity>
+using inplace_function = detail::basic_function<Sig, Capacity, false>;
+
+/// @brief A move-only function wrapper that stores small callables inline and
+/// allocates only for larger ones
+///
+/// @details
+/// `function` behaves like `inplace_function`, except that a callable that
+/// does not fit in the buffer, or could throw while being moved, is
+/// allocated on the heap instead of being rejected. The default buffer holds
+/// captures of up to four pointers, twice what most `std::function`
+/// implementations store without allocating.
+template <typename Sig, size_t Capacity = detail::default_function_capacity>
+using function = detail::basic_function<Sig, Capacity, true>;
+
+} // namespace jac
+
+#endif
@@ -0,0 +1,462 @@
+#ifndef JAC_HIVE_HPP
+#define JAC_HIVE_HPP
+
+/// @file
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <jac/maybe_uninit.hpp>
+
+namespace jac {
+
+namespace detail {
+
+// A block of element slots with a jump-counting skip field.
+//
+// Erased and never used slots form runs called skipblocks. The first and last
+// slot of each skipblock store its length in `skip`, while live slots store
+// zero, so iteration can jump over a whole skipblock in one step in either
+// direction. `skip` has one extra zero entry past the end as a sentinel. The
+// first slot of each skipblock is also a node in a doubly linked free list,
+// which is how erased slots are found again for reuse.
+template <typename T>
+struct hive_block {
+    static constexpr uint16_t npos = UINT16_MAX;
+
+    struct free_link {
+        uint16_t prev;
+        uint16_t next;
+    };
+
+    std::unique_ptr<maybe_uninit<T>[]> slots;
+    std::unique_ptr<uint16_t[]> skip;
+    std::unique_ptr<free_link[]> links;
+    uint16_t capacity;
+    uint16_t size{0};
+    uint16_t free_head{0};
+    // Neighbours in the sequence of all blocks
+    hive_block* prev{nullptr};
+    hive_block* next{nullptr};
+    // Neighbours in the list of blocks that have free slots
+    hive_block* prev_free{nullptr};
+    hive_block* next_free{nullptr};
+
+    // The whole block starts out as a single skipblock of unused slots
+    explicit hive_block(uint16_t cap)
+        : slots(new maybe_uninit<T>[cap]),
+          skip(new uint16_t[cap + 1]{}),
+          links(new free_link[cap]),
+          capacity(cap) {
+        skip[0] = cap;
+        skip[cap - 1] = cap;
+        links[0] = {npos, npos};
+    }
+
+    T* data(size_t idx) noexcept { return slots[idx].data(); }
+
+    void free_replace(uint16_t old_idx, uint16_t new_idx) noexcept {
+        auto link = links[old_idx];
+        links[new_idx] = link;
+        if (link.prev != npos) {
+            links[link.prev].next = new_idx;
+        } else {
+            free_head = new_idx;
+        }
+        if (link.next != npos) { links[link.next].prev = new_idx; }
+    }
+
+    void free_remove(uint16_t idx) noexcept {
+        auto link = links[idx];
+        if (link.prev != npos) {
+            links[link.prev].next = link.next;
+        } else {
+            free_head = link.next;
+        }
+        if (link.next != npos) { links[link.next].prev = link.prev; }
+    }
+
+    void free_push(uint16_t idx) noexcept {
+        links[idx] = {npos, free_head};
+        if (free_head != npos) { links[free_head].prev = idx; }
+        free_head = idx;
+    }
+
+    // Takes the first slot of the first free skipblock
+    uint16_t claim() noexcept {
+        auto idx = free_head;
+        auto len = skip[idx];
+        skip[idx] = 0;
+        if (len > 1) {
+            auto start = static_cast<uint16_t>(idx + 1);
+            skip[start] = static_cast<uint16_t>(len - 1);
+            skip[idx + len - 1] = static_cast<uint16_t>(len - 1);
+            free_replace(idx, start);
+        } else {
+            free_remove(idx);
+        }
+        ++size;
+        return idx;
+    }
+
+    // Marks a slot whose element was destroyed as free, merging it with the
+    // neighbouring skipblocks
+    void release(uint16_t idx) noexcept {
+        uint16_t left = idx > 0 ? skip[idx - 1] : 0;
+        uint16_t right = skip[idx + 1];
+        auto len = static_cast<uint16_t>(left + right + 1);
+        auto start = static_cast<uint16_t>(idx - left);
+        skip[start] = len;
+        skip[start + len - 1] = len;
+        if (left == 0 && right == 0) {
+            free_push(idx);
+        } else if (left == 0) {
+            free_replace(static_cast<uint16_t>(idx + 1), idx);
+        } else if (right != 0) {
+            free_remove(static_cast<uint16_t>(idx + 1));
+        }
+        --size;
+    }
+
+    size_t first() const noexcept { return skip[0]; }
+
+    size_t after(size_t idx) const noexcept {
+        ++idx;
+        return idx + skip[idx];
+    }
+
+    // Finds the live slot before `idx`, or `capacity` if there is none
+    size_t before(size_t idx) const noexcept {
+        if (idx == 0) { return capacity; }
+        auto j = idx - 1;
+        // `j` is either live or the last slot of a skipblock
+        size_t len = skip[j];
+        return len > j ? capacity : j - len;
+    }
+};
+
+} // namespace detail
+
+/// @brief An unordered container whose elements never move
+///
+/// @details
+/// `hive` stores its elements in a chain of blocks of increasing size.
+/// Elements are constructed in place and stay at the same address until
+/// they are erased, so pointers, references and iterators to them stay valid
+/// across any number of insertions and erasures of other elements. Insertion
+/// and erasure are O(1).
+///
+/// Erased slots are put on a free list and reused by later insertions, and
+/// a block is released as soon as its last element is erased. Iteration
+/// visits the elements in block order, jumping over runs of erased slots in
+/// a single step with a jump-counting skip field, so it stays fast even
+/// after many erasures.
+///
+/// The order of elements is unspecified; an insertion may fill a gap left by
+/// an earlier erasure anywhere in the container. `end()` is invalidated by
+/// insertions.
+template <typename T>
+class hive {
+  private:
+    using block = detail::hive_block<T>;
+
+    static constexpr size_t min_block = 8;
+    static constexpr size_t max_block = 8192;
+
+    block* head_{nullptr};
+    block* tail_{nullptr};
+    block* free_blocks_{nullptr};
+    size_t size_{0};
+    size_t capacity_{0};
+
+    void link_free(block* blk) noexcept {
+        blk->prev_free = nullptr;
+        blk->next_free = free_blocks_;
+        if (free_blocks_ != nullptr) { free_blocks_->prev_free = blk; }
+        free_blocks_ = blk;
+    }
+
+    void unlink_free(block* blk) noexcept {
+        if (blk->prev_free != nullptr) {
+            blk->prev_free->next_free = blk->next_free;
+        } else {
+            free_blocks_ = blk->next_free;
+        }
+        if (blk->next_free != nullptr) {
+            blk->next_free->prev_free = blk->prev_free;
+        }
+    }
+
+    block* free_block() {
+        if (free_blocks_ != nullptr) { return free_blocks_; }
+        auto cap = std::clamp(size_, min_block, max_block);
+        auto blk = new block(static_cast<uint16_t>(cap));
+        blk->prev = tail_;
+        if (tail_ != nullptr) {
+            tail_->next = blk;
+        } else {
+            head_ = blk;
+        }
+        tail_ = blk;
+        link_free(blk);
+        capacity_ += cap;
+        return blk;
+    }
+
+    void release_block(block* blk) noexcept {
+        unlink_free(blk);
+        if (blk->prev != nullptr) {
+            blk->prev->next = blk->next;
+        } else {
+            head_ = blk->next;
+        }
+        if (blk->next != nullptr) {
+            blk->next->prev = blk->prev;
+        } else {
+            tail_ = blk->prev;
+        }
+        capacity_ -= blk->capacity;
+        delete blk;
+    }
+
+    template <bool Const>
+    class basic_iterator {
+      private:
+        friend class hive;
+
+        block* blk_{nullptr};
+        size_t idx_{0};
+
+        basic_iterator(block* blk, size_t idx) noexcept
+            : blk_(blk), idx_(idx) {}
+
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = T;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+
+        basic_iterator() = default;
+
+        template <bool C = Const>
+            requires(C)
+        basic_iterator(const basic_iterator<false>& other) noexcept
+            : blk_(other.blk_), idx_(other.idx_) {}
+
+        reference operator*() const noexcept { return *blk_->data(idx_); }
+
+        pointer operator->() const noexcept { return blk_->data(idx_); }
+
+        basic_iterator& operator++() noexcept {
+            idx_ = blk_->after(idx_);
+            if (idx_ == blk_->capacity && blk_->next != nullptr) {
+                blk_ = blk_->next;
+                idx_ = blk_->first();
+            }
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        basic_iterator& operator--() noexcept {
+            idx_ = blk_->before(idx_);
+            if (idx_ == blk_->capacity) {
+                blk_ = blk_->prev;
+                idx_ = blk_->before(blk_->capacity);
+            }
+            return *this;
+        }
+
+        basic_iterator operator--(int) noexcept {
+            auto ret = *this;
+            --*this;
+            return ret;
+        }
+
+        friend bool operator==(const basic_iterator& lhs,
+                               const basic_iterator& rhs) noexcept {
+            return lhs.blk_ == rhs.blk_ && lhs.idx_ == rhs.idx_;
+        }
+    };
+
+  public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    hive() = default;
+
+    // Delegating to the default constructor makes the destructor clean up
+    // the elements already inserted if an insertion throws
+    hive(std::initializer_list<T> ilist) : hive() {
+        for (const auto& value : ilist) { insert(value); }
+    }
+
+    hive(const hive& other) : hive() {
+        for (const auto& value : other) { insert(value); }
+    }
+
+    hive(hive&& other) noexcept
+        : head_(std::exchange(other.head_, nullptr)),
+          tail_(std::exchange(other.tail_, nullptr)),
+          free_blocks_(std::exchange(other.free_blocks_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {}
+
+    ~hive() { clear(); }
+
+    hive& operator=(const hive& other) {
+        if (this != &other) { *this = hive(other); }
+        return *this;
+    }
+
+    hive& operator=(hive&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head_ = std::exchange(other.head_, nullptr);
+            tail_ = std::exchange(other.tail_, nullptr);
+            free_blocks_ = std::exchange(other.free_blocks_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+        return *this;
+    }
+
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Number of slots in all allocated blocks
+    size_type capacity() const noexcept { return capacity_; }
+
+    iterator begin() noexcept {
+        return head_ == nullptr ? end() : iterator(head_, head_->first());
+    }
+
+    const_iterator begin() const noexcept {
+        return head_ == nullptr ? end()
+                                : const_iterator(head_, head_->first());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept {
+        return tail_ == nullptr ? iterator() : iterator(tail_, tail_->capacity);
+    }
+
+    const_iterator end() const noexcept {
+        return tail_ == nullptr ? const_iterator()
+                                : const_iterator(tail_, tail_->capacity);
+    }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    /// @brief Constructs an element in a free slot
+    template <typename... Args>
+    iterator emplace(Args&&... args) {
+        auto fresh = free_blocks_ == nullptr;
+        auto blk = free_block();
+        auto idx = blk->free_head;
+        try {
+            std::construct_at(blk->data(idx), std::forward<Args>(args)...);
+        } catch (...) {
+            // A block with no live element would break iteration
+            if (fresh) { release_block(blk); }
+            throw;
+        }
+        blk->claim();
+        if (blk->free_head == block::npos) { unlink_free(blk); }
+        ++size_;
+        return iterator(blk, idx);
+    }
+
+    iterator insert(const T& value) { return emplace(value); }
+
+    iterator insert(T&& value) { return emplace(std::move(value)); }
+
+    /// @brief Destroys an element
+    ///
+    /// @return An iterator to the element following the erased one
+    iterator erase(const_iterator pos) noexcept {
+        auto blk = pos.blk_;
+        auto idx = static_cast<uint16_t>(pos.idx_);
+        iterator next(blk, idx);
+        ++next;
+
+        std::destroy_at(blk->data(idx));
+        auto was_full = blk->free_head == block::npos;
+        blk->release(idx);
+        --size_;
+        if (was_full) { link_free(blk); }
+        if (blk->size == 0) {
+            // Only the end iterator can still point into an empty block
+            auto at_end = next.blk_ == blk;
+            release_block(blk);
+            if (at_end) { next = end(); }
+        }
+        return next;
+    }
+
+    /// @brief Finds the iterator of an element from its address
+    ///
+    /// @details
+    /// This searches the blocks, so it is linear in the number of blocks,
+    /// which grows logarithmically with the size of the container.
+    iterator get_iterator(const T* ptr) noexcept {
+        for (auto blk = head_; blk != nullptr; blk = blk->next) {
+            auto first = blk->data(0);
+            if (!std::less<const T*>{}(ptr, first) &&
+                std::less<const T*>{}(ptr, first + blk->capacity)) {
+                return iterator(blk, static_cast<size_t>(ptr - first));
+            }
+        }
+        return end();
+    }
+
+    void clear() noexcept {
+        for (auto it = begin(); it != end(); ++it) { std::destroy_at(&*it); }
+        for (auto blk = head_; blk != nullptr;) {
+            delete std::exchange(blk, blk->next);
+        }
+        head_ = nullptr;
+        tail_ = nullptr;
+        free_blocks_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+    }
+
+    void swap(hive& other) noexcept {
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(free_blocks_, other.free_blocks_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+};
+
+template <typename T>
+void swap(hive<T>& lhs, hive<T>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace jac
+
+#endif
@@ -6,6 +6,7 @@
 #include <functional>
 
 #include <jac/macros.hpp>
+#include <jac/relocate.hpp>
 #include <jac/types.hpp>
 
 namespace jac {
@@ -197,7 +198,7 @@ class holder_impl<T[N]> {
 template <typename T, typename Tag = void>
 class holder {
   private:
-    detail::holder_impl<T> value_;
+    JAC_NO_UNIQ_ADDR detail::holder_impl<T> value_;
 
   public:
     using value_type = typename detail::holder_impl<T>::value_type;
@@ -415,17 +416,22 @@ class holder {
 template <typename T>
 holder(T&&) -> holder<T>;
 
+template <typename T, typename Tag>
+struct is_trivially_relocatable<holder<T, Tag>>
+    : is_trivially_relocatable<typename holder<T, Tag>::value_type> {};
+
 } // namespace jac
 
 template <typename T, typename Tag>
 struct std::hash<::jac::holder<T, Tag>> {
   private:
-    JAC_NO_UNIQ_ADDR std::hash<typename ::jac::holder<T, Tag>::value_type>
+    JAC_NO_UNIQ_ADDR std::hash<
+        std::remove_cvref_t<typename ::jac::holder<T, Tag>::value_type>>
         inner_;
 
   public:
     constexpr size_t operator()(const ::jac::holder<T, Tag>& value) const {
-        return inner_(value);
+        return inner_(*value);
     }
 };
 
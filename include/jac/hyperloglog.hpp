@@ -0,0 +1,286 @@
+#ifndef JAC_HYPERLOGLOG_HPP
+#define JAC_HYPERLOGLOG_HPP
+
+/// @file
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <jac/macros.hpp>
+#include <jac/option.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+/// @brief Estimates the number of distinct keys in a stream in fixed memory
+///
+/// @details
+/// `hyperloglog` splits the hash of each key into a register index and the
+/// position of the first set bit of the remaining bits, and keeps the largest
+/// such position per register. With precision `p` it uses `2^p` one-byte
+/// registers and has a relative standard error of about `1.04 / sqrt(2^p)`,
+/// e.g. 0.8% with the default precision of 14.
+///
+/// A new sketch starts out sparse, storing only the registers that have been
+/// set as a sorted list of index/value pairs, so that the many small sketches
+/// of a per-tenant metric stay small. It switches to the dense register array
+/// once the list would use more than half of the dense size.
+///
+/// Sketches with the same precision can be merged, e.g. to combine per-thread
+/// sketches, and serialized to a compact byte string. Keys are hashed with
+/// `Hash`, so `option` and `result` keys work out of the box through their
+/// `std::hash` specializations.
+template <typename T, typename Hash = std::hash<T>>
+class hyperloglog {
+  private:
+    static constexpr uint8_t dense_tag = 0;
+    static constexpr uint8_t sparse_tag = 1;
+
+    uint8_t precision_;
+    bool sparse_{true};
+    // Dense: one register per index. Sparse: unused.
+    std::vector<uint8_t> registers_;
+    // Sparse: `index << 8 | value` sorted by index. Dense: unused.
+    std::vector<uint32_t> entries_;
+    JAC_NO_UNIQ_ADDR Hash hasher_;
+
+    size_t register_count() const noexcept { return size_t{1} << precision_; }
+
+    size_t sparse_limit() const noexcept { return register_count() / 8; }
+
+    static uint32_t entry_index(uint32_t entry) noexcept { return entry >> 8; }
+
+    static uint8_t entry_value(uint32_t entry) noexcept {
+        return static_cast<uint8_t>(entry);
+    }
+
+    void set_sparse(uint32_t idx, uint8_t value) {
+        auto it = std::lower_bound(
+            entries_.begin(), entries_.end(), idx,
+            [](uint32_t e, uint32_t i) { return entry_index(e) < i; });
+        if (it != entries_.end() && entry_index(*it) == idx) {
+            if (entry_value(*it) < value) { *it = (idx << 8) | value; }
+            return;
+        }
+        entries_.insert(it, (idx << 8) | value);
+        if (entries_.size() > sparse_limit()) { densify(); }
+    }
+
+    void densify() {
+        registers_.assign(register_count(), 0);
+        for (auto e : entries_) { registers_[entry_index(e)] = entry_value(e); }
+        entries_.clear();
+        entries_.shrink_to_fit();
+        sparse_ = false;
+    }
+
+    void merge_sparse(const std::vector<uint32_t>& other) {
+        std::vector<uint32_t> merged;
+        merged.reserve(entries_.size() + other.size());
+        auto a = entries_.begin();
+        auto b = other.begin();
+        while (a != entries_.end() && b != other.end()) {
+            if (entry_index(*a) < entry_index(*b)) {
+                merged.push_back(*a++);
+            } else if (entry_index(*b) < entry_index(*a)) {
+                merged.push_back(*b++);
+            } else {
+                merged.push_back(std::max(*a++, *b++));
+            }
+        }
+        merged.insert(merged.end(), a, entries_.end());
+        merged.insert(merged.end(), b, other.end());
+        entries_ = std::move(merged);
+        if (entries_.size() > sparse_limit()) { densify(); }
+    }
+
+  public:
+    using key_type = T;
+    using hasher = Hash;
+    using size_type = size_t;
+
+    static constexpr uint8_t min_precision = 4;
+    static constexpr uint8_t max_precision = 18;
+
+    /// @brief Creates an empty sketch with `2^precision` registers
+    ///
+    /// @throws std::invalid_argument if the precision is outside of
+    /// [`min_precision`, `max_precision`]
+    explicit hyperloglog(uint8_t precision = 14, const Hash& hash = Hash())
+        : precision_(precision), hasher_(hash) {
+        if (precision < min_precision || precision > max_precision) {
+            throw std::invalid_argument("invalid jac::hyperloglog precision");
+        }
+    }
+
+    uint8_t precision() const noexcept { return precision_; }
+
+    /// @brief Checks if the sketch is still using the sparse representation
+    bool is_sparse() const noexcept { return sparse_; }
+
+    /// @brief Memory used by the registers, in bytes
+    size_type size_in_bytes() const noexcept {
+        return sparse_ ? entries_.size() * sizeof(uint32_t)
+                       : registers_.size();
+    }
+
+    /// @brief Resets the sketch to empty and sparse
+    void clear() noexcept {
+        registers_.clear();
+        registers_.shrink_to_fit();
+        entries_.clear();
+        sparse_ = true;
+    }
+
+    void insert(const T& key) {
+        auto h = hash_mix(hasher_(key));
+        auto idx = static_cast<uint32_t>(h >> (64 - precision_));
+        // A sentinel bit bounds the rank when the remaining bits are all zero
+        auto rest = (h << precision_) | (uint64_t{1} << (precision_ - 1));
+        auto rank = static_cast<uint8_t>(std::countl_zero(rest) + 1);
+        if (sparse_) {
+            set_sparse(idx, rank);
+        } else if (registers_[idx] < rank) {
+            registers_[idx] = rank;
+        }
+    }
+
+    /// @brief Estimates the number of distinct keys inserted
+    uint64_t estimate() const noexcept {
+        auto m = static_cast<double>(register_count());
+        double sum = 0.0;
+        size_type zeros = 0;
+        if (sparse_) {
+            zeros = register_count() - entries_.size();
+            sum = static_cast<double>(zeros);
+            for (auto e : entries_) { sum += std::ldexp(1.0, -entry_value(e)); }
+        } else {
+            for (auto r : registers_) {
+                sum += std::ldexp(1.0, -r);
+                zeros += r == 0;
+            }
+        }
+
+        double alpha = 0.7213 / (1.0 + 1.079 / m);
+        switch (precision_) {
+        case 4: alpha = 0.673; break;
+        case 5: alpha = 0.697; break;
+        case 6: alpha = 0.709; break;
+        default: break;
+        }
+        auto est = alpha * m * m / sum;
+        // Linear counting is more accurate while many registers are unset
+        if (est <= 2.5 * m && zeros != 0) {
+            est = m * std::log(m / static_cast<double>(zeros));
+        }
+        return static_cast<uint64_t>(std::llround(est));
+    }
+
+    /// @brief Adds the keys counted by another sketch to this one
+    ///
+    /// @details
+    /// Dense registers are combined with an element-wise maximum over
+    /// contiguous byte arrays, which compilers turn into SIMD code.
+    ///
+    /// @throws std::invalid_argument if the precisions differ
+    void merge(const hyperloglog& other) {
+        if (other.precision_ != precision_) {
+            throw std::invalid_argument(
+                "merging jac::hyperloglog sketches of different precision");
+        }
+        if (other.sparse_) {
+            if (sparse_) {
+                merge_sparse(other.entries_);
+            } else {
+                for (auto e : other.entries_) {
+                    auto& r = registers_[entry_index(e)];
+                    r = std::max(r, entry_value(e));
+                }
+            }
+            return;
+        }
+
+        if (sparse_) { densify(); }
+        auto dst = registers_.data();
+        auto src = other.registers_.data();
+        for (size_type i = 0; i < registers_.size(); ++i) {
+            dst[i] = std::max(dst[i], src[i]);
+        }
+    }
+
+    /// @brief Encodes the sketch as a compact byte string
+    ///
+    /// @details
+    /// The encoding is independent of the host's endianness. Sparse sketches
+    /// are stored as their index/value pairs and dense sketches as their raw
+    /// registers.
+    std::vector<std::byte> serialize() const {
+        std::vector<std::byte> out;
+        out.reserve(6 + size_in_bytes());
+        detail::store_le(out, sparse_ ? sparse_tag : dense_tag);
+        detail::store_le(out, precision_);
+        if (sparse_) {
+            detail::store_le(out, static_cast<uint32_t>(entries_.size()));
+            for (auto e : entries_) { detail::store_le(out, e); }
+        } else {
+            for (auto r : registers_) { detail::store_le(out, r); }
+        }
+        return out;
+    }
+
+    /// @brief Decodes a sketch produced by `serialize`
+    ///
+    /// @return The sketch, or `null` if `bytes` is not a valid encoding
+    static option<hyperloglog> deserialize(std::span<const std::byte> bytes,
+                                           const Hash& hash = Hash()) {
+        if (bytes.size() < 2) { return null; }
+        auto tag = detail::load_le<uint8_t>(bytes);
+        auto precision = detail::load_le<uint8_t>(bytes);
+        if (precision < min_precision || precision > max_precision) {
+            return null;
+        }
+
+        hyperloglog hll(precision, hash);
+        auto m = hll.register_count();
+        if (tag == dense_tag) {
+            if (bytes.size() != m) { return null; }
+            hll.registers_.resize(m);
+            for (auto& r : hll.registers_) {
+                r = detail::load_le<uint8_t>(bytes);
+                if (r > 65 - precision) { return null; }
+            }
+            hll.sparse_ = false;
+        } else if (tag == sparse_tag) {
+            if (bytes.size() < 4) { return null; }
+            auto count = detail::load_le<uint32_t>(bytes);
+            if (count > hll.sparse_limit() || bytes.size() != count * 4) {
+                return null;
+            }
+            hll.entries_.resize(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                auto e = detail::load_le<uint32_t>(bytes);
+                auto sorted =
+                    i == 0 || entry_index(hll.entries_[i - 1]) < entry_index(e);
+                if (!sorted || entry_index(e) >= m || entry_value(e) == 0 ||
+                    entry_value(e) > 65 - precision) {
+                    return null;
+                }
+                hll.entries_[i] = e;
+            }
+        } else {
+            return null;
+        }
+        return hll;
+    }
+};
+
+} // namespace jac
+
+#endif
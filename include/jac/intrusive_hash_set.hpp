@@ -0,0 +1,328 @@
+#ifndef JAC_INTRUSIVE_HASH_SET_HPP
+#define JAC_INTRUSIVE_HASH_SET_HPP
+
+/// @file
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <jac/macros.hpp>
+#include <jac/option.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+/// @brief Link fields embedded in an object so it can be put in an
+/// `intrusive_hash_set`
+///
+/// @details
+/// Like `list_hook`, copying a hook yields an unlinked hook and assigning one
+/// does nothing.
+class hash_set_hook {
+  private:
+    template <typename T,
+              hash_set_hook T::*Hook,
+              typename Hash,
+              typename KeyEqual>
+    friend class intrusive_hash_set;
+
+    hash_set_hook* next_{nullptr};
+    size_t hash_{0};
+    bool linked_{false};
+
+  public:
+    constexpr hash_set_hook() noexcept = default;
+
+    constexpr hash_set_hook(
+        [[maybe_unused]] const hash_set_hook& other) noexcept {}
+
+    constexpr hash_set_hook& operator=(
+        [[maybe_unused]] const hash_set_hook& other) noexcept {
+        return *this;
+    }
+
+    /// @brief Checks if the hook is currently in a set
+    constexpr bool is_linked() const noexcept { return linked_; }
+};
+
+/// @brief A hash set of objects that hold their own links
+///
+/// @details
+/// `intrusive_hash_set` does not own its elements. Each element embeds a
+/// `hash_set_hook`, named by `Hook`, which holds the element's chain link and
+/// its cached hash, so inserting and erasing elements never allocate. Only
+/// the bucket array is allocated, and it only grows when the number of
+/// elements exceeds the number of buckets, which `reserve` avoids.
+///
+/// Lookups can use any key type that `Hash` can hash and `KeyEqual` can
+/// compare with `T`, which allows finding objects by a key member without
+/// constructing an object. The default `KeyEqual` is `std::equal_to<>`.
+///
+/// The objects must outlive their membership in the set, and the parts of
+/// an object that affect its hash must not change while it is in the set.
+template <typename T,
+          hash_set_hook T::*Hook,
+          typename Hash = std::hash<T>,
+          typename KeyEqual = std::equal_to<>>
+class intrusive_hash_set {
+  private:
+    std::vector<hash_set_hook*> buckets_;
+    size_t size_{0};
+    JAC_NO_UNIQ_ADDR Hash hasher_;
+    JAC_NO_UNIQ_ADDR KeyEqual key_eq_;
+
+    static hash_set_hook& hook_of(const T& value) noexcept {
+        return const_cast<T&>(value).*Hook;
+    }
+
+    static T& value_of(hash_set_hook* hook) noexcept {
+        return *detail::owner_of<T, hash_set_hook, Hook>(hook);
+    }
+
+    template <typename K>
+    size_t hash_key(const K& key) const {
+        return static_cast<size_t>(hash_mix(hasher_(key)));
+    }
+
+    size_t bucket_of(size_t hash) const noexcept {
+        return hash & (buckets_.size() - 1);
+    }
+
+    // Finds the link that points to the first node matching `key`
+    template <typename K>
+    hash_set_hook** find_link(const K& key, size_t hash) const {
+        if (buckets_.empty()) { return nullptr; }
+        auto link = const_cast<hash_set_hook**>(&buckets_[bucket_of(hash)]);
+        for (; *link != nullptr; link = &(*link)->next_) {
+            if ((*link)->hash_ == hash && key_eq_(value_of(*link), key)) {
+                return link;
+            }
+        }
+        return nullptr;
+    }
+
+    static hash_set_hook* unlink(hash_set_hook** link) noexcept {
+        auto hook = *link;
+        *link = hook->next_;
+        hook->next_ = nullptr;
+        hook->linked_ = false;
+        return hook;
+    }
+
+    template <bool Const>
+    class basic_iterator {
+      private:
+        friend class intrusive_hash_set;
+
+        const std::vector<hash_set_hook*>* buckets_{nullptr};
+        size_t bucket_{0};
+        hash_set_hook* hook_{nullptr};
+
+        basic_iterator(const std::vector<hash_set_hook*>* buckets,
+                       size_t bucket,
+                       hash_set_hook* hook) noexcept
+            : buckets_(buckets), bucket_(bucket), hook_(hook) {
+            skip_empty();
+        }
+
+        void skip_empty() noexcept {
+            while (hook_ == nullptr && ++bucket_ < buckets_->size()) {
+                hook_ = (*buckets_)[bucket_];
+            }
+        }
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = T;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+
+        basic_iterator() = default;
+
+        template <bool C = Const>
+            requires(C)
+        basic_iterator(const basic_iterator<false>& other) noexcept
+            : buckets_(other.buckets_),
+              bucket_(other.bucket_),
+              hook_(other.hook_) {}
+
+        reference operator*() const noexcept { return value_of(hook_); }
+
+        pointer operator->() const noexcept { return &value_of(hook_); }
+
+        basic_iterator& operator++() noexcept {
+            hook_ = hook_->next_;
+            skip_empty();
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            auto ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        friend bool operator==(const basic_iterator& lhs,
+                               const basic_iterator& rhs) noexcept {
+            return lhs.hook_ == rhs.hook_;
+        }
+    };
+
+  public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    intrusive_hash_set() = default;
+
+    explicit intrusive_hash_set(size_type bucket_count,
+                                const Hash& hash = Hash(),
+                                const KeyEqual& equal = KeyEqual())
+        : hasher_(hash), key_eq_(equal) {
+        reserve(bucket_count);
+    }
+
+    intrusive_hash_set(const intrusive_hash_set&) = delete;
+
+    intrusive_hash_set(intrusive_hash_set&& other) noexcept
+        : buckets_(std::move(other.buckets_)),
+          size_(std::exchange(other.size_, 0)),
+          hasher_(std::move(other.hasher_)),
+          key_eq_(std::move(other.key_eq_)) {
+        other.buckets_.clear();
+    }
+
+    ~intrusive_hash_set() { clear(); }
+
+    intrusive_hash_set& operator=(const intrusive_hash_set&) = delete;
+
+    intrusive_hash_set& operator=(intrusive_hash_set&& other) noexcept {
+        if (this != &other) {
+            clear();
+            buckets_ = std::move(other.buckets_);
+            other.buckets_.clear();
+            size_ = std::exchange(other.size_, 0);
+            hasher_ = std::move(other.hasher_);
+            key_eq_ = std::move(other.key_eq_);
+        }
+        return *this;
+    }
+
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    size_type bucket_count() const noexcept { return buckets_.size(); }
+
+    hasher hash_function() const { return hasher_; }
+
+    iterator begin() noexcept {
+        return buckets_.empty() ? end() : iterator(&buckets_, 0, buckets_[0]);
+    }
+
+    const_iterator begin() const noexcept {
+        return buckets_.empty() ? end()
+                                : const_iterator(&buckets_, 0, buckets_[0]);
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(); }
+
+    const_iterator end() const noexcept { return const_iterator(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    /// @brief Grows the bucket array to hold `count` elements without
+    /// rehashing
+    void reserve(size_type count) {
+        if (count <= buckets_.size()) { return; }
+        std::vector<hash_set_hook*> buckets(std::bit_ceil(count), nullptr);
+        auto mask = buckets.size() - 1;
+        for (auto head : buckets_) {
+            while (head != nullptr) {
+                auto next = head->next_;
+                auto& bucket = buckets[head->hash_ & mask];
+                head->next_ = bucket;
+                bucket = head;
+                head = next;
+            }
+        }
+        buckets_ = std::move(buckets);
+    }
+
+    /// @brief Links an object into the set, unless an equal one is already
+    /// present
+    ///
+    /// @return `true` if the object was inserted
+    bool insert(T& value) {
+        auto hash = hash_key(value);
+        if (find_link(value, hash) != nullptr) { return false; }
+        if (size_ + 1 > buckets_.size()) {
+            reserve(std::max<size_type>(8, buckets_.size() * 2));
+        }
+        auto& hook = hook_of(value);
+        auto& bucket = buckets_[bucket_of(hash)];
+        hook.hash_ = hash;
+        hook.next_ = bucket;
+        hook.linked_ = true;
+        bucket = &hook;
+        ++size_;
+        return true;
+    }
+
+    /// @brief Finds the object that compares equal to `key`
+    template <typename K = T>
+    option<T&> find(const K& key) const {
+        auto link = find_link(key, hash_key(key));
+        return link == nullptr ? option<T&>() : option<T&>(value_of(*link));
+    }
+
+    template <typename K = T>
+    bool contains(const K& key) const {
+        return find(key).has_value();
+    }
+
+    /// @brief Unlinks and returns the object that compares equal to `key`
+    template <typename K = T>
+    option<T&> extract(const K& key) {
+        auto link = find_link(key, hash_key(key));
+        if (link == nullptr) { return null; }
+        --size_;
+        return value_of(unlink(link));
+    }
+
+    /// @brief Unlinks an object that is in this set
+    void erase(T& value) noexcept {
+        auto& hook = hook_of(value);
+        auto link = &buckets_[bucket_of(hook.hash_)];
+        while (*link != &hook) { link = &(*link)->next_; }
+        unlink(link);
+        --size_;
+    }
+
+    /// @brief Unlinks every object
+    void clear() noexcept {
+        for (auto& head : buckets_) {
+            while (head != nullptr) { unlink(&head); }
+        }
+        size_ = 0;
+    }
+};
+
+} // namespace jac
+
+#endif
@@ -0,0 +1,303 @@
+#ifndef JAC_INTRUSIVE_LIST_HPP
+#define JAC_INTRUSIVE_LIST_HPP
+
+/// @file
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <jac/option.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+/// @brief Link fields embedded in an object so it can be put on an
+/// `intrusive_list`
+///
+/// @details
+/// Copying a hook yields an unlinked hook and assigning one does nothing, so
+/// objects containing hooks can be copied without corrupting any list. An
+/// object must be erased from its list before it is destroyed.
+class list_hook {
+  private:
+    template <typename T, list_hook T::*Hook>
+    friend class intrusive_list;
+
+    list_hook* prev_{nullptr};
+    list_hook* next_{nullptr};
+
+  public:
+    constexpr list_hook() noexcept = default;
+
+    constexpr list_hook([[maybe_unused]] const list_hook& other) noexcept {}
+
+    constexpr list_hook& operator=(
+        [[maybe_unused]] const list_hook& other) noexcept {
+        return *this;
+    }
+
+    /// @brief Checks if the hook is currently on a list
+    constexpr bool is_linked() const noexcept { return next_ != nullptr; }
+};
+
+/// @brief A doubly linked list of objects that hold their own links
+///
+/// @details
+/// `intrusive_list` does not own or allocate anything. The links live in a
+/// `list_hook` member of `T` named by `Hook`, so inserting and erasing never
+/// allocate, and an object with several hooks can be on several lists at
+/// once. Since the links are in the object, an object can be erased in O(1)
+/// given only a reference to it.
+/// ```
+/// struct connection {
+///     int fd;
+///     jac::list_hook state_hook;
+///     jac::list_hook timeout_hook;
+/// };
+///
+/// jac::intrusive_list<connection, &connection::state_hook> idle, active;
+///
+/// idle.erase(conn);
+/// active.push_back(conn);
+/// ```
+///
+/// The objects must outlive their membership in the list. Destroying or
+/// clearing the list unlinks every object.
+template <typename T, list_hook T::*Hook>
+class intrusive_list {
+  private:
+    // Sentinel of the circular list, whose `next_` is the first element
+    list_hook head_;
+    size_t size_{0};
+
+    static list_hook& hook_of(T& value) noexcept { return value.*Hook; }
+
+    static T& value_of(list_hook* hook) noexcept {
+        return *detail::owner_of<T, list_hook, Hook>(hook);
+    }
+
+    void init() noexcept {
+        head_.prev_ = &head_;
+        head_.next_ = &head_;
+    }
+
+    static void link_before(list_hook* pos, list_hook* hook) noexcept {
+        hook->prev_ = pos->prev_;
+        hook->next_ = pos;
+        pos->prev_->next_ = hook;
+        pos->prev_ = hook;
+    }
+
+    static void unlink(list_hook* hook) noexcept {
+        hook->prev_->next_ = hook->next_;
+        hook->next_->prev_ = hook->prev_;
+        hook->prev_ = nullptr;
+        hook->next_ = nullptr;
+    }
+
+    void steal(intrusive_list& other) noexcept {
+        if (other.empty()) {
+            init();
+            return;
+        }
+        head_.prev_ = other.head_.prev_;
+        head_.next_ = other.head_.next_;
+        head_.prev_->next_ = &head_;
+        head_.next_->prev_ = &head_;
+        size_ = std::exchange(other.size_, 0);
+        other.init();
+    }
+
+    template <bool Const>
+    class basic_iterator {
+      private:
+        friend class intrusive_list;
+
+        list_hook* hook_{nullptr};
+
+        explicit basic_iterator(list_hook* hook) noexcept : hook_(hook) {}
+
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = T;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+
+        basic_iterator() = default;
+
+        template <bool C = Const>
+            requires(C)
+        basic_iterator(const basic_iterator<false>& other) noexcept
+            : hook_(other.hook_) {}
+
+        reference operator*() const noexcept { return value_of(hook_); }
+
+        pointer operator->() const noexcept { return &value_of(hook_); }
+
+        basic_iterator& operator++() noexcept {
+            hook_ = hook_->next_;
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            auto ret = *this;
+            hook_ = hook_->next_;
+            return ret;
+        }
+
+        basic_iterator& operator--() noexcept {
+            hook_ = hook_->prev_;
+            return *this;
+        }
+
+        basic_iterator operator--(int) noexcept {
+            auto ret = *this;
+            hook_ = hook_->prev_;
+            return ret;
+        }
+
+        friend bool operator==(const basic_iterator& lhs,
+                               const basic_iterator& rhs) noexcept {
+            return lhs.hook_ == rhs.hook_;
+        }
+    };
+
+  public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    intrusive_list() noexcept { init(); }
+
+    intrusive_list(const intrusive_list&) = delete;
+
+    intrusive_list(intrusive_list&& other) noexcept { steal(other); }
+
+    ~intrusive_list() { clear(); }
+
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    intrusive_list& operator=(intrusive_list&& other) noexcept {
+        if (this != &other) {
+            clear();
+            steal(other);
+        }
+        return *this;
+    }
+
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    iterator begin() noexcept { return iterator(head_.next_); }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(head_.next_);
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(&head_); }
+
+    const_iterator end() const noexcept {
+        return const_iterator(const_cast<list_hook*>(&head_));
+    }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    /// @brief Gets the iterator of an object that is on this list
+    static iterator iterator_to(T& value) noexcept {
+        return iterator(&hook_of(value));
+    }
+
+    option<T&> front() noexcept {
+        return empty() ? option<T&>() : option<T&>(value_of(head_.next_));
+    }
+
+    option<T&> back() noexcept {
+        return empty() ? option<T&>() : option<T&>(value_of(head_.prev_));
+    }
+
+    /// @brief Links `value` before `pos`
+    ///
+    /// @details
+    /// `value` must not already be on a list through the same hook.
+    iterator insert(const_iterator pos, T& value) noexcept {
+        auto hook = &hook_of(value);
+        link_before(pos.hook_, hook);
+        ++size_;
+        return iterator(hook);
+    }
+
+    void push_front(T& value) noexcept { insert(begin(), value); }
+
+    void push_back(T& value) noexcept { insert(end(), value); }
+
+    /// @brief Unlinks an object from this list
+    ///
+    /// @return An iterator to the element following the erased one
+    iterator erase(const_iterator pos) noexcept {
+        auto next = pos.hook_->next_;
+        unlink(pos.hook_);
+        --size_;
+        return iterator(next);
+    }
+
+    /// @brief Unlinks an object that is on this list
+    void erase(T& value) noexcept { erase(iterator_to(value)); }
+
+    /// @brief Unlinks and returns the first object
+    option<T&> pop_front() noexcept {
+        auto value = front();
+        if (value) { erase(begin()); }
+        return value;
+    }
+
+    /// @brief Unlinks and returns the last object
+    option<T&> pop_back() noexcept {
+        auto value = back();
+        if (value) { erase(iterator(head_.prev_)); }
+        return value;
+    }
+
+    /// @brief Moves an object that is on this list to the back
+    void move_to_back(T& value) noexcept {
+        auto hook = &hook_of(value);
+        unlink(hook);
+        link_before(&head_, hook);
+    }
+
+    /// @brief Moves an object that is on this list to the front
+    void move_to_front(T& value) noexcept {
+        auto hook = &hook_of(value);
+        unlink(hook);
+        link_before(head_.next_, hook);
+    }
+
+    /// @brief Unlinks every object
+    void clear() noexcept {
+        while (!empty()) { erase(begin()); }
+    }
+
+    void swap(intrusive_list& other) noexcept {
+        intrusive_list tmp(std::move(other));
+        other.steal(*this);
+        steal(tmp);
+    }
+};
+
+template <typename T, list_hook T::*Hook>
+void swap(intrusive_list<T, Hook>& lhs, intrusive_list<T, Hook>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace jac
+
+#endif
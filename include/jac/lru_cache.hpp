@@ -0,0 +1,231 @@
+#ifndef JAC_LRU_CACHE_HPP
+#define JAC_LRU_CACHE_HPP
+
+/// @file
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <jac/hive.hpp>
+#include <jac/intrusive_hash_set.hpp>
+#include <jac/intrusive_list.hpp>
+#include <jac/macros.hpp>
+#include <jac/option.hpp>
+#include <jac/result.hpp>
+
+namespace jac {
+
+/// @brief Cost function that counts every cache entry as 1
+struct unit_cost {
+    template <typename K, typename V>
+    constexpr size_t operator()(
+        [[maybe_unused]] const K& key,
+        [[maybe_unused]] const V& value) const noexcept {
+        return 1;
+    }
+};
+
+/// @brief A cache that evicts the least recently used entries
+///
+/// @details
+/// Every entry lives in a single node, stored in a `hive`, that holds the key,
+/// the value, and the hooks for both an `intrusive_hash_set` index and an
+/// `intrusive_list` in recency order. Lookups, insertions and evictions are
+/// O(1), and once the cache has warmed up, inserting an entry reuses the
+/// node of an evicted one instead of allocating.
+///
+/// The capacity limits the total cost of the entries, where the cost of each
+/// entry is computed by `Cost` when it is inserted. With the default
+/// `unit_cost` the capacity is a number of entries; a cost function returning
+/// e.g. the byte size of the value bounds the memory used instead. An entry
+/// whose cost alone exceeds the capacity is still inserted, after evicting
+/// every other entry.
+///
+/// References returned by the cache stay valid until their entry is evicted
+/// or erased.
+template <typename K,
+          typename V,
+          typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>,
+          typename Cost = unit_cost>
+class lru_cache {
+  private:
+    struct entry {
+        K key;
+        V value;
+        size_t cost;
+        hash_set_hook index_hook;
+        list_hook order_hook;
+        // Where the entry lives in `entries_`, so that it is erased without
+        // searching the blocks of the hive
+        typename hive<entry>::const_iterator self;
+    };
+
+    struct entry_hash {
+        JAC_NO_UNIQ_ADDR Hash hash;
+
+        size_t operator()(const entry& e) const { return hash(e.key); }
+
+        size_t operator()(const K& key) const { return hash(key); }
+    };
+
+    struct entry_equal {
+        JAC_NO_UNIQ_ADDR KeyEqual equal;
+
+        bool operator()(const entry& lhs, const entry& rhs) const {
+            return equal(lhs.key, rhs.key);
+        }
+
+        bool operator()(const entry& lhs, const K& rhs) const {
+            return equal(lhs.key, rhs);
+        }
+    };
+
+    // Declared first so that the entries outlive the containers linking them
+    hive<entry> entries_;
+    intrusive_hash_set<entry, &entry::index_hook, entry_hash, entry_equal>
+        index_;
+    // Most recently used first
+    intrusive_list<entry, &entry::order_hook> order_;
+    size_t capacity_;
+    size_t total_cost_{0};
+    JAC_NO_UNIQ_ADDR Cost cost_;
+
+    void remove(entry& e) noexcept {
+        index_.erase(e);
+        order_.erase(e);
+        total_cost_ -= e.cost;
+        entries_.erase(e.self);
+    }
+
+    // Evicts from the back until the cost fits, never evicting `keep`
+    void evict_for(const entry& keep) noexcept {
+        while (total_cost_ > capacity_ && &*order_.back() != &keep) {
+            remove(*order_.back());
+        }
+    }
+
+    template <typename KArg, typename... Args>
+    entry& add(KArg&& key, Args&&... args) {
+        auto it = entries_.emplace(
+            entry{K(std::forward<KArg>(key)), V(std::forward<Args>(args)...),
+                  0, {}, {}, {}});
+        auto& e = *it;
+        e.self = it;
+        try {
+            e.cost = cost_(e.key, e.value);
+            index_.insert(e);
+        } catch (...) {
+            entries_.erase(it);
+            throw;
+        }
+        order_.push_front(e);
+        total_cost_ += e.cost;
+        evict_for(e);
+        return e;
+    }
+
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using size_type = size_t;
+
+    /// @brief Creates a cache whose entries may cost at most `capacity` in
+    /// total
+    explicit lru_cache(size_type capacity,
+                       const Cost& cost = Cost(),
+                       const Hash& hash = Hash(),
+                       const KeyEqual& equal = KeyEqual())
+        : index_(0, entry_hash{hash}, entry_equal{equal}),
+          capacity_(capacity),
+          cost_(cost) {}
+
+    lru_cache(const lru_cache&) = delete;
+
+    lru_cache& operator=(const lru_cache&) = delete;
+
+    size_type size() const noexcept { return index_.size(); }
+
+    bool empty() const noexcept { return index_.empty(); }
+
+    size_type capacity() const noexcept { return capacity_; }
+
+    hasher hash_function() const { return index_.hash_function().hash; }
+
+    /// @brief Sum of the costs of all entries
+    size_type total_cost() const noexcept { return total_cost_; }
+
+    /// @brief Looks up an entry and marks it as most recently used
+    option<V&> get(const K& key) {
+        auto e = index_.find(key);
+        if (!e) { return null; }
+        order_.move_to_front(*e);
+        return e->value;
+    }
+
+    /// @brief Looks up an entry without affecting its recency
+    option<const V&> peek(const K& key) const {
+        return index_.find(key).transform(
+            [](const entry& e) -> const V& { return e.value; });
+    }
+
+    bool contains(const K& key) const { return index_.contains(key); }
+
+    /// @brief Inserts or replaces an entry, evicting others as needed
+    template <typename U>
+    V& put(const K& key, U&& value) {
+        if (auto e = index_.find(key)) {
+            e->value = std::forward<U>(value);
+            total_cost_ -= e->cost;
+            e->cost = cost_(e->key, e->value);
+            total_cost_ += e->cost;
+            order_.move_to_front(*e);
+            evict_for(*e);
+            return e->value;
+        }
+        return add(key, std::forward<U>(value)).value;
+    }
+
+    /// @brief Gets an entry, or creates it with `make` if it is missing
+    ///
+    /// @details
+    /// `make` is called without arguments and returns a `result<V, E>`. If it
+    /// returns an error, nothing is inserted and the error is returned.
+    template <typename F>
+    auto try_get_or_insert(const K& key, F&& make)
+        -> result<V&, typename std::invoke_result_t<F>::error_type> {
+        using ret = result<V&, typename std::invoke_result_t<F>::error_type>;
+        if (auto value = get(key)) { return ret(std::in_place, *value); }
+        auto made = std::invoke(std::forward<F>(make));
+        if (!made.has_value()) {
+            return ret(in_place_error, std::move(made).error());
+        }
+        return ret(std::in_place, add(key, *std::move(made)).value);
+    }
+
+    /// @brief Removes an entry
+    ///
+    /// @return The value of the removed entry, if there was one
+    option<V> erase(const K& key) {
+        auto e = index_.find(key);
+        if (!e) { return null; }
+        option<V> value(std::move(e->value));
+        remove(*e);
+        return value;
+    }
+
+    void clear() noexcept {
+        index_.clear();
+        order_.clear();
+        entries_.clear();
+        total_cost_ = 0;
+    }
+};
+
+} // namespace jac
+
+#endif
@@ -12,22 +12,105 @@
 /// ## Smart Pointers (Single Object Containers)
 ///  Type | Brief
 /// ------|-------
+/// @ref jac::cow "cow<T, Refcount=atomic_refcount>" | @copybrief jac::cow
 /// @ref jac::holder "holder<T, Tag=void>" | @copybrief jac::holder
 /// @ref jac::maybe_uninit "maybe_uninit<T>" | @copybrief jac::maybe_uninit
 /// @ref jac::option "option<T>" | @copybrief jac::option
+/// @ref jac::poly "poly<Base, Size>" | @copybrief jac::poly
 /// @ref jac::result "result<T, E>" | @copybrief jac::result
+/// @ref jac::tagged_ptr "tagged_ptr<T, Bits>" | @copybrief jac::tagged_ptr
+///
+/// ## Sum and Product Types
+///  Type | Brief
+/// ------|-------
+/// @ref jac::packed_tuple "packed_tuple<Ts...>" | @copybrief jac::packed_tuple
+/// @ref jac::variant "variant<Ts...>" | @copybrief jac::variant
+///
+/// ## Function Wrappers
+///  Type | Brief
+/// ------|-------
+/// @ref jac::function "function<Sig, Capacity>" | @copybrief jac::function
+/// @ref jac::inplace_function "inplace_function<Sig, Capacity>" | @copybrief jac::inplace_function
+///
+/// ## Pipelines
+///  Type | Brief
+/// ------|-------
+/// @ref jac::pipeline "pipeline<Steps...>" | @copybrief jac::pipeline
+/// @ref jac::values_view "values_view<V>" | @copybrief jac::values_view
+/// @ref jac::errors_view "errors_view<V>" | @copybrief jac::errors_view
+/// @ref jac::partitioned_results "partitioned_results<V>" | @copybrief jac::partitioned_results
+///
+/// ## Sequence Containers
+///  Type | Brief
+/// ------|-------
+/// @ref jac::bitset "bitset" | @copybrief jac::bitset
+/// @ref jac::compressed_sorted_seq "compressed_sorted_seq" | @copybrief jac::compressed_sorted_seq
+/// @ref jac::hive "hive<T>" | @copybrief jac::hive
+/// @ref jac::intrusive_list "intrusive_list<T, Hook>" | @copybrief jac::intrusive_list
+/// @ref jac::packed_int_vector "packed_int_vector<Bits>" | @copybrief jac::packed_int_vector
+/// @ref jac::result_vector "result_vector<T, E>" | @copybrief jac::result_vector
+/// @ref jac::ring_buffer "ring_buffer<T, Capacity>" | @copybrief jac::ring_buffer
+///
+/// ## Associative Containers
+///  Type | Brief
+/// ------|-------
+/// @ref jac::btree_map "btree_map<K, V, Compare, NodeSize>" | @copybrief jac::btree_map
+/// @ref jac::intrusive_hash_set "intrusive_hash_set<T, Hook, Hash, KeyEqual>" | @copybrief jac::intrusive_hash_set
+/// @ref jac::static_map "static_map<K, V, N>" | @copybrief jac::static_map
+///
+/// ## Caches
+///  Type | Brief
+/// ------|-------
+/// @ref jac::clock_cache "clock_cache<K, V, Hash, KeyEqual>" | @copybrief jac::clock_cache
+/// @ref jac::lru_cache "lru_cache<K, V, Hash, KeyEqual, Cost>" | @copybrief jac::lru_cache
+/// @ref jac::sharded_cache "sharded_cache<Cache>" | @copybrief jac::sharded_cache
+///
+/// ## Priority Queues
+///  Type | Brief
+/// ------|-------
+/// @ref jac::dary_heap "dary_heap<T, D, Compare>" | @copybrief jac::dary_heap
+/// @ref jac::indexed_dary_heap "indexed_dary_heap<T, D, Compare>" | @copybrief jac::indexed_dary_heap
+/// @ref jac::timer_wheel "timer_wheel<T>" | @copybrief jac::timer_wheel
+///
+/// ## Probabilistic Data Structures
+///  Type | Brief
+/// ------|-------
+/// @ref jac::bloom_filter "bloom_filter<T, Hash>" | @copybrief jac::bloom_filter
+/// @ref jac::count_min_sketch "count_min_sketch<T, Hash>" | @copybrief jac::count_min_sketch
+/// @ref jac::cuckoo_filter "cuckoo_filter<T, Hash>" | @copybrief jac::cuckoo_filter
+/// @ref jac::hyperloglog "hyperloglog<T, Hash>" | @copybrief jac::hyperloglog
+///
+/// ## Indexes
+///  Type | Brief
+/// ------|-------
+/// @ref jac::rank_select_index "rank_select_index" | @copybrief jac::rank_select_index
 ///
 /// ## Utility Types
 ///  Type | Brief
 /// ------|-------
 /// @ref jac::null_t "null_t" | @copybrief jac::null_t
 /// @ref jac::void_t "void_t" | @copybrief jac::void_t
+/// @ref jac::atomic_refcount "atomic_refcount" | @copybrief jac::atomic_refcount
 /// @ref jac::error "error" | @copybrief jac::error
+/// @ref jac::hash_set_hook "hash_set_hook" | @copybrief jac::hash_set_hook
+/// @ref jac::list_hook "list_hook" | @copybrief jac::list_hook
+/// @ref jac::local_refcount "local_refcount" | @copybrief jac::local_refcount
+/// @ref jac::sorted_unique_t "sorted_unique_t" | @copybrief jac::sorted_unique_t
+/// @ref jac::unit_cost "unit_cost" | @copybrief jac::unit_cost
+///
+/// ## Traits
+///  Trait | Brief
+/// -------|-------
+/// @ref jac::is_trivially_relocatable "is_trivially_relocatable<T>" | @copybrief jac::is_trivially_relocatable
+/// @ref jac::seeded_hash "seeded_hash<T>" | @copybrief jac::seeded_hash
+/// @ref jac::variant_size "variant_size<V>" | @copybrief jac::variant_size
 ///
 /// ## Constants
 ///  Constant | Brief
 /// ----------|-------
 /// @ref jac::null "null" | @copybrief jac::null
+/// @ref jac::sorted_unique "sorted_unique" | @copybrief jac::sorted_unique
+/// @ref jac::variant_npos "variant_npos" | @copybrief jac::variant_npos
 /// @ref jac::void_v "void_v" | @copybrief jac::void_v
 
 #if !defined(_MSC_VER) || defined(DOXYGEN)
@@ -36,4 +119,32 @@
 #define JAC_NO_UNIQ_ADDR [[msvc::no_unique_address]]
 #endif
 
+#if defined(__GNUC__) || defined(__clang__)
+#define JAC_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define JAC_PREFETCH(addr) static_cast<void>(addr)
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define JAC_UNREACHABLE() __builtin_unreachable()
+#elif defined(_MSC_VER)
+#define JAC_UNREACHABLE() __assume(false)
+#else
+#define JAC_UNREACHABLE() static_cast<void>(0)
+#endif
+
+// The number of address bits starting at bit 48 that are always zero in
+// user-space pointers, leaving the top byte alone on AArch64 where it may
+// hold a hardware tag. On x86-64 this covers the top byte too, so it must be
+// lowered when Linear Address Masking or 57-bit addresses are in use
+#ifndef JAC_POINTER_HIGH_BITS
+#if defined(__x86_64__) || defined(_M_X64)
+#define JAC_POINTER_HIGH_BITS 16
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define JAC_POINTER_HIGH_BITS 8
+#else
+#define JAC_POINTER_HIGH_BITS 0
+#endif
+#endif
+
 #endif
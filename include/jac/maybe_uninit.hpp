@@ -42,6 +42,12 @@ class maybe_uninit {
     constexpr explicit(!std::is_convertible_v<U, T>) maybe_uninit(U&& value)
         : value_(std::forward<U>(value)) {}
 
+    constexpr ~maybe_uninit()
+        requires(std::is_trivially_destructible_v<T>)
+    = default;
+
+    constexpr ~maybe_uninit() {}
+
     template <typename... Args>
     constexpr T& construct(Args&&... args) {
         return *std::construct_at(&value_, std::forward<Args>(args)...);
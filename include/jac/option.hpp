@@ -6,9 +6,11 @@
 #include <exception>
 #include <functional>
 #include <optional>
+#include <ranges>
 
 #include <jac/holder.hpp>
 #include <jac/macros.hpp>
+#include <jac/relocate.hpp>
 #include <jac/types.hpp>
 #include <jac/utils.hpp>
 
@@ -33,6 +35,8 @@ class option_impl {
     using pointer = typename holder<T>::pointer;
     using const_pointer = typename holder<T>::const_pointer;
 
+    constexpr option_impl() = default;
+
     template <typename... Args>
     explicit constexpr option_impl(std::in_place_t in_place, Args&&... args)
         : value_(in_place, std::forward<Args>(args)...) {}
@@ -77,6 +81,8 @@ class option_impl<T&> {
     using pointer = typename holder<T&>::pointer;
     using const_pointer = typename holder<T&>::const_pointer;
 
+    constexpr option_impl() = default;
+
     template <typename U>
     explicit constexpr option_impl(U* ptr) : value_(static_cast<T*>(ptr)) {}
 
@@ -134,6 +140,8 @@ class option_impl<void_t> {
     using pointer = typename holder<void_t>::pointer;
     using const_pointer = typename holder<void_t>::const_pointer;
 
+    constexpr option_impl() = default;
+
     template <typename... Args>
     explicit constexpr option_impl([[maybe_unused]] std::in_place_t in_place,
                                    [[maybe_unused]] Args&&... args)
@@ -290,8 +298,8 @@ class option {
         : impl_(std::in_place, std::forward<U>(value)) {}
 
     template <typename U = std::remove_reference_t<T>>
-        requires(std::is_lvalue_reference_v<U>)
-    constexpr explicit(!std::is_convertible_v<U*, T*>) option(U* ptr)
+        requires(std::is_lvalue_reference_v<T>)
+    constexpr explicit(!std::is_convertible_v<U*, pointer>) option(U* ptr)
         : impl_(ptr) {}
 
     constexpr ~option() = default;
@@ -386,6 +394,25 @@ class option {
 
     constexpr const_pointer operator->() const noexcept { return impl_.ptr(); }
 
+    /// @brief Iterates over the value, if there is one
+    ///
+    /// @details
+    /// An `option` is a contiguous range of zero or one elements, so it can
+    /// be used in range-based for loops and range pipelines.
+    constexpr pointer begin() noexcept {
+        return impl_.has_value() ? impl_.ptr() : nullptr;
+    }
+
+    constexpr const_pointer begin() const noexcept {
+        return impl_.has_value() ? impl_.ptr() : nullptr;
+    }
+
+    constexpr pointer end() noexcept { return begin() + impl_.has_value(); }
+
+    constexpr const_pointer end() const noexcept {
+        return begin() + impl_.has_value();
+    }
+
     constexpr void reset() { impl_.reset(); }
 
     template <typename... Args>
@@ -497,7 +524,7 @@ class option {
             return option<ret_t>(
                 std::invoke(std::forward<F>(f), std::move(impl_).get()));
         } else {
-            return opiont<ret_t>();
+            return option<ret_t>();
         }
     }
 
@@ -552,6 +579,10 @@ class option {
 template <typename T>
 option(T&&) -> option<T>;
 
+template <typename T>
+struct is_trivially_relocatable<option<T>>
+    : is_trivially_relocatable<typename option<T>::value_type> {};
+
 template <typename T>
 constexpr void swap(option<T>& a, option<T>& b) {
     a.swap(b);
@@ -659,21 +690,37 @@ constexpr option<T> make_option(std::initializer_list<U> ilist,
     return option<T>(std::in_place, ilist, std::forward<Args>(args)...);
 }
 
+namespace detail {
+
+template <typename T>
+inline constexpr bool is_option_v = false;
+
+template <typename T>
+inline constexpr bool is_option_v<option<T>> = true;
+
+} // namespace detail
+
 } // namespace jac
 
 template <typename T>
 struct std::hash<::jac::option<T>> {
   private:
-    JAC_NO_UNIQ_ADDR std::hash<T> inner_;
+    JAC_NO_UNIQ_ADDR std::hash<std::remove_cvref_t<T>> inner_;
     JAC_NO_UNIQ_ADDR std::hash<bool> bool_hasher_;
 
   public:
     constexpr size_t operator()(const ::jac::option<T>& value) const {
         auto has_val = value.has_value();
         size_t h = bool_hasher_(has_val);
-        if (has_val) { h = ::jac::hash_combine(h, inner_(value)); }
+        if (has_val) { h = ::jac::hash_combine(h, inner_(*value)); }
         return h;
     }
 };
 
+// An option of a reference only points to its value, so iterators into it
+// stay valid after the option is destroyed
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<::jac::option<T&>> =
+    true;
+
 #endif
@@ -0,0 +1,239 @@
+#ifndef JAC_PACKED_INT_VECTOR_HPP
+#define JAC_PACKED_INT_VECTOR_HPP
+
+/// @file
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <jac/macros.hpp>
+
+namespace jac {
+
+namespace detail {
+
+constexpr uint64_t packed_mask(size_t width) noexcept {
+    return width == 64 ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+}
+
+// Reads `width` bits at `bit` from a word array that has a readable word
+// past the last one holding data.
+constexpr uint64_t packed_read(const uint64_t* words,
+                               size_t bit,
+                               size_t width) noexcept {
+    auto idx = bit / 64;
+    auto off = bit % 64;
+    // The double shift yields zero instead of overflowing when `off` is zero
+    auto hi = (words[idx + 1] << 1) << (63 - off);
+    return ((words[idx] >> off) | hi) & packed_mask(width);
+}
+
+constexpr void packed_write(uint64_t* words,
+                            size_t bit,
+                            size_t width,
+                            uint64_t value) noexcept {
+    auto idx = bit / 64;
+    auto off = bit % 64;
+    auto mask = packed_mask(width);
+    value &= mask;
+    words[idx] = (words[idx] & ~(mask << off)) | (value << off);
+    if (off + width > 64) {
+        auto shift = 64 - off;
+        words[idx + 1] = (words[idx + 1] & ~(mask >> shift)) | (value >> shift);
+    }
+}
+
+// Decodes 64 values of width `W`, which occupy exactly `W` words. Since `W`
+// is a constant, every shift and word offset is too once the loop is
+// unrolled, which lets the compiler vectorize it.
+template <size_t W, typename U>
+void packed_unpack_block(const uint64_t* words, U* out) noexcept {
+    for (size_t i = 0; i < 64; ++i) {
+        out[i] = static_cast<U>(packed_read(words, i * W, W));
+    }
+}
+
+template <typename U, size_t... W>
+constexpr auto packed_unpack_table(
+    [[maybe_unused]] std::index_sequence<W...> seq) noexcept {
+    using fn = void (*)(const uint64_t*, U*) noexcept;
+    return std::array<fn, sizeof...(W)>{&packed_unpack_block<W + 1, U>...};
+}
+
+template <size_t Bits>
+struct packed_width {
+    static constexpr size_t value() noexcept { return Bits; }
+};
+
+template <>
+struct packed_width<std::dynamic_extent> {
+    size_t width;
+
+    constexpr size_t value() const noexcept { return width; }
+};
+
+} // namespace detail
+
+/// @brief A vector of unsigned integers stored in exactly `Bits` bits each
+///
+/// @details
+/// Elements are packed back to back without padding, so e.g. 11-bit codes
+/// take 11 bits instead of the 32 they would take in a `std::vector<uint32_t>`.
+/// The width is fixed at compile time with `Bits`, or chosen at construction
+/// when `Bits` is `std::dynamic_extent`. Widths from 1 to 64 are supported.
+///
+/// Random access reads and writes touch at most two words. For scanning,
+/// `unpack` decodes a range of elements into a caller buffer in blocks of 64,
+/// using a decoder specialized for the width so that the compiler can unroll
+/// and vectorize it; this is also the case for a runtime width.
+///
+/// Values wider than the element width are truncated on write.
+template <size_t Bits = std::dynamic_extent>
+class packed_int_vector {
+    static_assert(Bits == std::dynamic_extent || (Bits >= 1 && Bits <= 64),
+                  "packed_int_vector width must be from 1 to 64 bits");
+
+  private:
+    // One extra word is always allocated so that a read can load the word
+    // following the element's first word unconditionally.
+    std::vector<uint64_t> words_{0};
+    size_t size_{0};
+    JAC_NO_UNIQ_ADDR detail::packed_width<Bits> width_;
+
+    static constexpr size_t word_count(size_t bits) noexcept {
+        return (bits + 63) / 64 + 1;
+    }
+
+  public:
+    using value_type = uint64_t;
+    using size_type = size_t;
+
+    constexpr packed_int_vector()
+        requires(Bits != std::dynamic_extent)
+    = default;
+
+    /// @brief Creates a vector of `size` zeroed elements
+    explicit packed_int_vector(size_type size)
+        requires(Bits != std::dynamic_extent)
+        : words_(word_count(size * Bits)), size_(size) {}
+
+    /// @brief Creates a vector of `size` zeroed `width`-bit elements
+    ///
+    /// @throws std::invalid_argument if `width` is not from 1 to 64
+    explicit packed_int_vector(size_type size, size_type width)
+        requires(Bits == std::dynamic_extent)
+        : words_(word_count(size * width)), size_(size), width_{width} {
+        if (width == 0 || width > 64) {
+            throw std::invalid_argument("invalid jac::packed_int_vector width");
+        }
+    }
+
+    /// @brief Number of bits per element
+    constexpr size_type width() const noexcept { return width_.value(); }
+
+    /// @brief Largest value that can be stored
+    constexpr value_type max_value() const noexcept {
+        return detail::packed_mask(width());
+    }
+
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Number of elements that fit without reallocating
+    size_type capacity() const noexcept {
+        return (words_.capacity() - 1) * 64 / width();
+    }
+
+    /// @brief Memory used by the packed elements, in bytes
+    size_type size_in_bytes() const noexcept {
+        return words_.size() * sizeof(uint64_t);
+    }
+
+    void reserve(size_type count) {
+        words_.reserve(word_count(count * width()));
+    }
+
+    /// @brief Changes the number of elements, setting any new ones to zero
+    void resize(size_type count) {
+        if (count < size_) {
+            // Clear the dropped bits so that growing again yields zeros
+            for (auto i = count; i < size_; ++i) { set(i, 0); }
+        }
+        words_.resize(word_count(count * width()));
+        size_ = count;
+    }
+
+    void clear() noexcept {
+        words_.assign(1, 0);
+        size_ = 0;
+    }
+
+    value_type get(size_type idx) const noexcept {
+        return detail::packed_read(words_.data(), idx * width(), width());
+    }
+
+    value_type operator[](size_type idx) const noexcept { return get(idx); }
+
+    void set(size_type idx, value_type value) noexcept {
+        detail::packed_write(words_.data(), idx * width(), width(), value);
+    }
+
+    void push_back(value_type value) {
+        words_.resize(word_count((size_ + 1) * width()));
+        set(size_++, value);
+    }
+
+    /// @brief Decodes `out.size()` elements starting at `first` into `out`
+    ///
+    /// @details
+    /// `U` must be wide enough to hold the elements.
+    template <std::unsigned_integral U>
+    void unpack(size_type first, std::span<U> out) const noexcept {
+        if constexpr (Bits != std::dynamic_extent) {
+            static_assert(sizeof(U) * 8 >= Bits,
+                          "unpack destination is narrower than the elements");
+        }
+        auto w = width();
+        auto data = words_.data();
+        auto dst = out.data();
+        auto last = first + out.size();
+
+        auto pos = first;
+        for (; pos < last && pos % 64 != 0; ++pos) {
+            *dst++ = static_cast<U>(detail::packed_read(data, pos * w, w));
+        }
+        if constexpr (Bits != std::dynamic_extent) {
+            for (; pos + 64 <= last; pos += 64, dst += 64) {
+                detail::packed_unpack_block<Bits>(data + pos / 64 * Bits, dst);
+            }
+        } else {
+            static constexpr auto table = detail::packed_unpack_table<U>(
+                std::make_index_sequence<64>{});
+            auto block = table[w - 1];
+            for (; pos + 64 <= last; pos += 64, dst += 64) {
+                block(data + pos / 64 * w, dst);
+            }
+        }
+        for (; pos < last; ++pos) {
+            *dst++ = static_cast<U>(detail::packed_read(data, pos * w, w));
+        }
+    }
+
+    friend bool operator==(const packed_int_vector& lhs,
+                           const packed_int_vector& rhs) noexcept {
+        // Bits past the last element are always zero
+        return lhs.size_ == rhs.size_ && lhs.width() == rhs.width() &&
+               lhs.words_ == rhs.words_;
+    }
+};
+
+} // namespace jac
+
+#endif
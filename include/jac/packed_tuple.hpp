@@ -0,0 +1,255 @@
+#ifndef JAC_PACKED_TUPLE_HPP
+#define JAC_PACKED_TUPLE_HPP
+
+/// @file
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <jac/holder.hpp>
+#include <jac/macros.hpp>
+#include <jac/relocate.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+namespace detail {
+
+template <typename... Ts>
+struct packed_tuple_layout {
+    // The element indices in order of decreasing alignment, keeping elements
+    // of equal alignment in declaration order
+    static constexpr std::array<size_t, sizeof...(Ts)> order = [] {
+        std::array<size_t, sizeof...(Ts)> order{};
+        std::array<size_t, sizeof...(Ts)> align{alignof(holder<Ts>)...};
+        for (size_t i = 0; i < order.size(); ++i) {
+            auto j = i;
+            for (; j > 0 && align[order[j - 1]] < align[i]; --j) {
+                order[j] = order[j - 1];
+            }
+            order[j] = i;
+        }
+        return order;
+    }();
+};
+
+template <typename Layout, size_t... I>
+auto packed_tuple_order(std::index_sequence<I...> seq)
+    -> std::index_sequence<Layout::order[I]...>;
+
+template <size_t I, typename T>
+struct packed_tuple_leaf {
+    JAC_NO_UNIQ_ADDR holder<T> value;
+
+    constexpr packed_tuple_leaf() = default;
+
+    template <typename U>
+    constexpr packed_tuple_leaf([[maybe_unused]] std::in_place_t in_place,
+                                U&& arg)
+        : value(std::forward<U>(arg)) {}
+};
+
+template <typename Order, typename... Ts>
+struct packed_tuple_storage;
+
+// Bases are laid out in declaration order, so listing the leaves by
+// decreasing alignment leaves no padding between them
+template <size_t... P, typename... Ts>
+struct packed_tuple_storage<std::index_sequence<P...>, Ts...>
+    : packed_tuple_leaf<P, std::tuple_element_t<P, std::tuple<Ts...>>>... {
+    constexpr packed_tuple_storage() = default;
+
+    template <typename... Us>
+    constexpr packed_tuple_storage(std::in_place_t in_place,
+                                   std::tuple<Us...> args)
+        : packed_tuple_leaf<P, std::tuple_element_t<P, std::tuple<Ts...>>>(
+              in_place,
+              std::get<P>(std::move(args)))... {}
+};
+
+template <typename... Ts>
+using packed_tuple_storage_for = packed_tuple_storage<
+    decltype(packed_tuple_order<packed_tuple_layout<Ts...>>(
+        std::index_sequence_for<Ts...>())),
+    Ts...>;
+
+} // namespace detail
+
+/// @brief A tuple that orders its elements in memory to minimize padding
+///
+/// @details
+/// `std::tuple` lays out its elements in a fixed order, so a tuple that mixes
+/// large and small types wastes space on padding between them. A
+/// `packed_tuple` stores its elements by decreasing alignment instead, which
+/// makes it as small as the elements allow, while `get<I>` still uses the
+/// declaration order. For example, `packed_tuple<bool, uint64_t, uint8_t,
+/// uint32_t>` takes 16 bytes where the same `std::tuple` takes 24.
+///
+/// Elements are stored in a `holder`, so references and `void` are allowed,
+/// and empty elements take no space. Comparisons are lexicographic in
+/// declaration order.
+/// ```
+/// jac::packed_tuple<bool, uint64_t, uint8_t> key(true, id, shard);
+/// auto [active, user, s] = key;
+/// ```
+template <typename... Ts>
+class packed_tuple {
+  private:
+    detail::packed_tuple_storage_for<Ts...> storage_;
+
+    template <size_t I>
+    using leaf = detail::packed_tuple_leaf<
+        I,
+        std::tuple_element_t<I, std::tuple<Ts...>>>;
+
+    template <size_t I>
+    constexpr auto& at() noexcept {
+        return static_cast<leaf<I>&>(storage_).value;
+    }
+
+    template <size_t I>
+    constexpr const auto& at() const noexcept {
+        return static_cast<const leaf<I>&>(storage_).value;
+    }
+
+    template <size_t... I>
+    constexpr bool equals(
+        const packed_tuple& other,
+        [[maybe_unused]] std::index_sequence<I...> seq) const {
+        return ((at<I>() == other.at<I>()) && ...);
+    }
+
+    template <size_t I = 0>
+    constexpr auto compare(const packed_tuple& other) const {
+        if constexpr (I + 1 == sizeof...(Ts)) {
+            return at<I>() <=> other.at<I>();
+        } else {
+            using ordering = std::common_comparison_category_t<
+                std::compare_three_way_result_t<holder<Ts>>...>;
+            ordering cmp = at<I>() <=> other.at<I>();
+            if (cmp != 0) { return cmp; }
+            return ordering(compare<I + 1>(other));
+        }
+    }
+
+  public:
+    constexpr packed_tuple() = default;
+
+    /// @brief Creates a tuple from one argument per element, in declaration
+    /// order
+    template <typename... Us>
+        requires(sizeof...(Us) == sizeof...(Ts) && sizeof...(Ts) > 0 &&
+                 (std::is_constructible_v<holder<Ts>, Us &&> && ...) &&
+                 !(sizeof...(Us) == 1 &&
+                   (std::is_same_v<std::remove_cvref_t<Us>, packed_tuple> &&
+                    ...)))
+    constexpr packed_tuple(Us&&... args)
+        : storage_(std::in_place,
+                   std::forward_as_tuple(std::forward<Us>(args)...)) {}
+
+    /// @brief Gets the element at index `I` in declaration order
+    template <size_t I>
+    constexpr decltype(auto) get() & noexcept {
+        return *at<I>();
+    }
+
+    template <size_t I>
+    constexpr decltype(auto) get() const& noexcept {
+        return *at<I>();
+    }
+
+    template <size_t I>
+    constexpr decltype(auto) get() && noexcept {
+        return *std::move(at<I>());
+    }
+
+    template <size_t I>
+    constexpr decltype(auto) get() const&& noexcept {
+        return *std::move(at<I>());
+    }
+
+    constexpr void swap(packed_tuple& other) {
+        [&]<size_t... I>([[maybe_unused]] std::index_sequence<I...> seq) {
+            (at<I>().swap(other.at<I>()), ...);
+        }(std::index_sequence_for<Ts...>());
+    }
+
+    friend constexpr void swap(packed_tuple& lhs, packed_tuple& rhs) {
+        lhs.swap(rhs);
+    }
+
+    friend constexpr bool operator==(const packed_tuple& lhs,
+                                     const packed_tuple& rhs) {
+        return lhs.equals(rhs, std::index_sequence_for<Ts...>());
+    }
+
+    friend constexpr auto operator<=>(const packed_tuple& lhs,
+                                      const packed_tuple& rhs)
+        requires(sizeof...(Ts) > 0)
+    {
+        return lhs.compare(rhs);
+    }
+};
+
+template <typename... Ts>
+packed_tuple(Ts...) -> packed_tuple<Ts...>;
+
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(packed_tuple<Ts...>& t) noexcept {
+    return t.template get<I>();
+}
+
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(const packed_tuple<Ts...>& t) noexcept {
+    return t.template get<I>();
+}
+
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(packed_tuple<Ts...>&& t) noexcept {
+    return std::move(t).template get<I>();
+}
+
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(const packed_tuple<Ts...>&& t) noexcept {
+    return std::move(t).template get<I>();
+}
+
+template <typename... Ts>
+struct is_trivially_relocatable<packed_tuple<Ts...>>
+    : std::bool_constant<(is_trivially_relocatable_v<holder<Ts>> && ...)> {};
+
+} // namespace jac
+
+template <typename... Ts>
+struct std::tuple_size<::jac::packed_tuple<Ts...>>
+    : std::integral_constant<size_t, sizeof...(Ts)> {};
+
+template <size_t I, typename... Ts>
+struct std::tuple_element<I, ::jac::packed_tuple<Ts...>> {
+    using type = typename ::jac::holder<
+        std::tuple_element_t<I, std::tuple<Ts...>>>::value_type;
+};
+
+template <typename... Ts>
+struct std::hash<::jac::packed_tuple<Ts...>> {
+    size_t operator()(const ::jac::packed_tuple<Ts...>& value) const {
+        return [&]<size_t... I>(
+                   [[maybe_unused]] std::index_sequence<I...> seq) {
+            size_t h = 0;
+            ((h = ::jac::hash_combine(
+                  h,
+                  std::hash<std::remove_cvref_t<std::tuple_element_t<
+                      I, ::jac::packed_tuple<Ts...>>>>()(
+                      value.template get<I>()))),
+             ...);
+            return h;
+        }(std::index_sequence_for<Ts...>());
+    }
+};
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef JAC_PARALLEL_HPP
+#define JAC_PARALLEL_HPP
+
+/// @file
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <jac/option.hpp>
+#include <jac/result.hpp>
+
+namespace jac {
+
+/// @brief Which error a parallel algorithm returns when several elements fail
+enum class first_error {
+    /// The error of the failing element with the lowest index, which is the
+    /// error a sequential loop would return
+    by_index,
+    /// The error that was found first, which stops the other workers sooner
+    by_time,
+};
+
+/// @brief Options for `parallel_try_transform` and `parallel_try_for_each`
+struct parallel_options {
+    /// The number of threads, including the calling thread, or 0 for
+    /// `std::thread::hardware_concurrency()`
+    size_t threads = 0;
+    /// The number of consecutive elements each worker takes at a time, or 0
+    /// to split the input into a few chunks per thread
+    size_t chunk_size = 0;
+    first_error order = first_error::by_index;
+};
+
+namespace detail {
+
+// The state shared by the workers of one parallel algorithm
+//
+// Workers take chunks in increasing order and process an element only if
+// its index is below `limit_`. An error lowers the limit to its index when
+// errors are ordered by index, so that every element before it is still
+// checked, or to 0 when errors are ordered by time, and an exception always
+// lowers it to 0.
+template <typename E>
+class parallel_run {
+  private:
+    size_t size_;
+    size_t chunk_;
+    first_error order_;
+    std::atomic<size_t> next_{0};
+    std::atomic<size_t> limit_;
+    std::mutex mutex_;
+    option<E> error_;
+    size_t error_index_;
+    std::exception_ptr exception_;
+
+    void lower_limit(size_t limit) noexcept {
+        if (limit < limit_.load(std::memory_order_relaxed)) {
+            limit_.store(limit, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename Err>
+    void fail(size_t index, Err&& err) {
+        std::lock_guard lock(mutex_);
+        bool first = order_ == first_error::by_time ? !error_.has_value()
+                                                    : index < error_index_;
+        if (first) {
+            error_.emplace(std::forward<Err>(err));
+            error_index_ = index;
+        }
+        lower_limit(order_ == first_error::by_time ? 0 : error_index_);
+    }
+
+  public:
+    parallel_run(size_t size, size_t chunk, first_error order)
+        : size_(size),
+          chunk_(chunk),
+          order_(order),
+          limit_(size),
+          error_index_(size) {}
+
+    /// Calls `body(i)`, which returns a result, on chunks of indices until
+    /// none are left or the run is cancelled
+    template <typename Body>
+    void work(Body& body) noexcept {
+        try {
+            while (true) {
+                size_t begin =
+                    next_.fetch_add(chunk_, std::memory_order_relaxed);
+                if (begin >= limit_.load(std::memory_order_relaxed)) { return; }
+                size_t end = std::min(begin + chunk_, size_);
+                for (size_t i = begin;
+                     i < end && i < limit_.load(std::memory_order_relaxed);
+                     ++i) {
+                    auto r = body(i);
+                    if (!r.has_value()) {
+                        fail(i, std::move(r).error());
+                        return;
+                    }
+                }
+            }
+        } catch (...) {
+            std::lock_guard lock(mutex_);
+            if (exception_ == nullptr) {
+                exception_ = std::current_exception();
+            }
+            lower_limit(0);
+        }
+    }
+
+    result<void, E> finish() && {
+        if (exception_ != nullptr) { std::rethrow_exception(exception_); }
+        if (error_.has_value()) {
+            return result<void, E>(in_place_error, *std::move(error_));
+        }
+        return result<void, E>(std::in_place);
+    }
+};
+
+template <typename E, typename Body>
+result<void, E> parallel_try(size_t size,
+                             const parallel_options& options,
+                             Body body) {
+    size_t threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(size_t(std::thread::hardware_concurrency()),
+                           size_t(1));
+    }
+    size_t chunk = options.chunk_size;
+    if (chunk == 0) { chunk = std::max(size / (threads * 4), size_t(1)); }
+    threads = std::min(threads, (size + chunk - 1) / chunk);
+
+    parallel_run<E> run(size, chunk, options.order);
+    {
+        // Joined before the result is read, including when starting a thread
+        // throws
+        std::vector<std::jthread> workers;
+        if (threads > 1) { workers.reserve(threads - 1); }
+        for (size_t t = 1; t < threads; ++t) {
+            workers.emplace_back([&run, &body] { run.work(body); });
+        }
+        run.work(body);
+    }
+    return std::move(run).finish();
+}
+
+template <typename F, typename R>
+using parallel_result_t = std::remove_cvref_t<
+    std::invoke_result_t<F&, std::ranges::range_reference_t<R>>>;
+
+template <typename R, typename F>
+concept parallel_try_range =
+    std::ranges::random_access_range<R> && std::ranges::sized_range<R> &&
+    std::invocable<F&, std::ranges::range_reference_t<R>> &&
+    is_result_v<parallel_result_t<F, R>>;
+
+} // namespace detail
+
+/// @brief Applies `f`, which returns a `result`, to every element of `r` on
+/// several threads, writing the values to `out`, or returns the first error
+///
+/// @details
+/// The input is split into chunks that the calling thread and
+/// `options.threads - 1` other threads take in order, and the value for
+/// `r[i]` is assigned to `out[i]`, so `out` must refer to at least
+/// `std::ranges::size(r)` elements that can be assigned from different
+/// threads. When `f` returns an error, the other workers stop taking
+/// elements, without waiting for the rest of the input:
+///
+/// - With `first_error::by_index`, the default, the elements before the
+///   failing one are still processed, and the error of the lowest failing
+///   index is returned, as for a sequential loop.
+/// - With `first_error::by_time`, every worker stops at its next element,
+///   and the error that was found first is returned.
+///
+/// After an error, the elements of `out` are unspecified. `f` is called
+/// concurrently through the same reference, so it must be safe to call from
+/// several threads. If `f` throws, the workers stop and the first exception
+/// is rethrown.
+/// ```
+/// std::vector<record> records(rows.size());
+/// auto status = jac::parallel_try_transform(rows, records.begin(), validate);
+/// if (!status.has_value()) { reject_batch(status.error()); }
+/// ```
+template <typename R, std::random_access_iterator Out, typename F>
+    requires detail::parallel_try_range<R, F> &&
+             std::indirectly_writable<
+                 Out,
+                 typename detail::parallel_result_t<F, R>::rvalue_reference>
+result<void, typename detail::parallel_result_t<F, R>::error_type>
+parallel_try_transform(R&& r,
+                       Out out,
+                       F f,
+                       const parallel_options& options = {}) {
+    using diff = std::iter_difference_t<Out>;
+    auto first = std::ranges::begin(r);
+    return detail::parallel_try<
+        typename detail::parallel_result_t<F, R>::error_type>(
+        std::ranges::size(r), options, [&](size_t i) {
+            auto mapped = std::invoke(f, first[diff(i)]);
+            if (mapped.has_value()) { out[diff(i)] = *std::move(mapped); }
+            return mapped;
+        });
+}
+
+/// @brief Calls `f`, which returns a `result`, on every element of `r` on
+/// several threads, or returns the first error
+///
+/// @details
+/// The values returned by `f` are discarded. Chunking, cancellation and the
+/// choice of error are the same as for `parallel_try_transform`.
+/// ```
+/// auto status = jac::parallel_try_for_each(
+///     files, check_checksum, {.order = jac::first_error::by_time});
+/// ```
+template <typename R, typename F>
+    requires detail::parallel_try_range<R, F>
+result<void, typename detail::parallel_result_t<F, R>::error_type>
+parallel_try_for_each(R&& r, F f, const parallel_options& options = {}) {
+    using diff = std::ranges::range_difference_t<R>;
+    auto first = std::ranges::begin(r);
+    return detail::parallel_try<
+        typename detail::parallel_result_t<F, R>::error_type>(
+        std::ranges::size(r), options, [&](size_t i) {
+            return std::invoke(f, first[diff(i)]);
+        });
+}
+
+} // namespace jac
+
+#endif
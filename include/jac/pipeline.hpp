@@ -0,0 +1,257 @@
+#ifndef JAC_PIPELINE_HPP
+#define JAC_PIPELINE_HPP
+
+/// @file
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <jac/macros.hpp>
+#include <jac/option.hpp>
+#include <jac/result.hpp>
+#include <jac/types.hpp>
+
+namespace jac {
+
+template <typename... Steps>
+class pipeline;
+
+namespace detail {
+
+template <typename T>
+concept option_or_result = is_option_v<std::remove_cvref_t<T>> ||
+                           is_result_v<std::remove_cvref_t<T>>;
+
+enum class pipeline_op { then, map, or_else };
+
+template <pipeline_op Op, typename F>
+struct pipeline_step {
+    static constexpr pipeline_op op = Op;
+
+    JAC_NO_UNIQ_ADDR F f;
+};
+
+// The type produced by applying a step eagerly with the member functions of
+// option and result, which the fused pipeline reproduces
+template <typename R, typename Step>
+struct pipeline_step_output;
+
+template <typename R, typename F>
+struct pipeline_step_output<R, pipeline_step<pipeline_op::then, F>> {
+    using type = decltype(std::declval<R>().and_then(std::declval<const F&>()));
+};
+
+// Computed directly rather than through transform, which cannot produce an
+// option or result of void
+template <typename R, typename F>
+struct pipeline_step_output<R, pipeline_step<pipeline_op::map, F>> {
+  private:
+    using value = std::invoke_result_t<const F&, decltype(*std::declval<R>())>;
+
+    template <typename T>
+    struct rebind;
+
+    template <typename T>
+    struct rebind<option<T>> {
+        using type = option<value>;
+    };
+
+    template <typename T, typename E>
+    struct rebind<result<T, E>> {
+        using type = result<value, E>;
+    };
+
+  public:
+    using type = typename rebind<std::remove_cvref_t<R>>::type;
+};
+
+template <typename R, typename F>
+struct pipeline_step_output<R, pipeline_step<pipeline_op::or_else, F>> {
+    using type = decltype(std::declval<R>().or_else(std::declval<const F&>()));
+};
+
+template <typename R, typename... Steps>
+struct pipeline_output {
+    using type = std::remove_cvref_t<R>;
+};
+
+template <typename R, typename Step, typename... Rest>
+struct pipeline_output<R, Step, Rest...>
+    : pipeline_output<typename pipeline_step_output<R, Step>::type, Rest...> {
+};
+
+// The error of an empty option, which carries nothing
+struct pipeline_none {};
+
+template <typename Out, size_t I, typename Steps, typename V>
+constexpr Out pipeline_value(const Steps& steps, V&& value);
+
+template <typename Out, size_t I, typename Steps, typename Err>
+constexpr Out pipeline_error(const Steps& steps, Err&& err);
+
+// The only branch on each option or result, which continues with either
+// its value or its error
+template <typename Out, size_t I, typename Steps, typename R>
+constexpr Out pipeline_dispatch(const Steps& steps, R&& r) {
+    if (r.has_value()) {
+        return pipeline_value<Out, I>(steps, *std::forward<R>(r));
+    } else if constexpr (is_option_v<std::remove_cvref_t<R>>) {
+        return pipeline_error<Out, I>(steps, pipeline_none());
+    } else {
+        return pipeline_error<Out, I>(steps, std::forward<R>(r).error());
+    }
+}
+
+template <typename Out, size_t I, typename Steps, typename V>
+constexpr Out pipeline_value(const Steps& steps, V&& value) {
+    if constexpr (I == std::tuple_size_v<Steps>) {
+        return Out(std::in_place, std::forward<V>(value));
+    } else {
+        const auto& step = std::get<I>(steps);
+        constexpr auto op = std::remove_cvref_t<decltype(step)>::op;
+        if constexpr (op == pipeline_op::then) {
+            return pipeline_dispatch<Out, I + 1>(
+                steps, std::invoke(step.f, std::forward<V>(value)));
+        } else if constexpr (op == pipeline_op::map) {
+            // Mapped values are passed on directly instead of being wrapped
+            if constexpr (std::is_void_v<decltype(std::invoke(
+                              step.f, std::forward<V>(value)))>) {
+                std::invoke(step.f, std::forward<V>(value));
+                return pipeline_value<Out, I + 1>(steps, void_t());
+            } else {
+                return pipeline_value<Out, I + 1>(
+                    steps, std::invoke(step.f, std::forward<V>(value)));
+            }
+        } else {
+            return pipeline_value<Out, I + 1>(steps, std::forward<V>(value));
+        }
+    }
+}
+
+template <typename Out, size_t I, typename Steps, typename Err>
+constexpr Out pipeline_error(const Steps& steps, Err&& err) {
+    constexpr bool none =
+        std::is_same_v<std::remove_cvref_t<Err>, pipeline_none>;
+    if constexpr (I == std::tuple_size_v<Steps>) {
+        if constexpr (none) {
+            return Out();
+        } else {
+            return Out(in_place_error, std::forward<Err>(err));
+        }
+    } else {
+        const auto& step = std::get<I>(steps);
+        constexpr auto op = std::remove_cvref_t<decltype(step)>::op;
+        if constexpr (op != pipeline_op::or_else) {
+            return pipeline_error<Out, I + 1>(steps, std::forward<Err>(err));
+        } else if constexpr (none) {
+            return pipeline_dispatch<Out, I + 1>(steps, std::invoke(step.f));
+        } else {
+            return pipeline_dispatch<Out, I + 1>(
+                steps, std::invoke(step.f, std::forward<Err>(err)));
+        }
+    }
+}
+
+template <pipeline_op Op, typename F>
+constexpr auto make_pipeline(F&& f) {
+    using step = pipeline_step<Op, std::decay_t<F>>;
+    return pipeline<step>(std::tuple<step>(step{std::forward<F>(f)}));
+}
+
+} // namespace detail
+
+/// @brief A chain of `then`, `map` and `or_else` steps applied to an
+/// `option` or `result` in one pass
+///
+/// @details
+/// Chaining the member functions `and_then`, `transform` and `or_else`
+/// creates a new `option` or `result` at every step, and each one is checked
+/// again by the next step. A pipeline instead passes values and errors
+/// directly from one step to the next, so the only branches left are on the
+/// options and results returned by `then` and `or_else` functions, and the
+/// final `option` or `result` is constructed once. The type it produces is
+/// the same as that of the equivalent chain of member functions.
+///
+/// Pipelines are built with `jac::then`, `jac::map` and `jac::or_else`,
+/// joined with `|`, and applied with `|` or by calling them, which makes a
+/// pipeline usable with `std::views::transform` over a range of options or
+/// results.
+/// ```
+/// auto validate = jac::then(parse) | jac::map(normalize) |
+///                 jac::then(check_range) | jac::or_else(use_default);
+///
+/// auto port = read_field("port") | validate;
+/// auto ports = fields | std::views::transform(validate);
+/// ```
+template <typename... Steps>
+class pipeline {
+  private:
+    template <typename... Others>
+    friend class pipeline;
+
+    std::tuple<Steps...> steps_;
+
+    template <typename... Others>
+    constexpr pipeline<Steps..., Others...> concat(
+        pipeline<Others...>&& other) && {
+        return pipeline<Steps..., Others...>(
+            std::tuple_cat(std::move(steps_), std::move(other.steps_)));
+    }
+
+  public:
+    explicit constexpr pipeline(std::tuple<Steps...> steps)
+        : steps_(std::move(steps)) {}
+
+    /// @brief Applies every step to `r`
+    template <typename R>
+        requires detail::option_or_result<R>
+    constexpr auto operator()(R&& r) const {
+        using out = typename detail::pipeline_output<R&&, Steps...>::type;
+        return detail::pipeline_dispatch<out, 0>(steps_, std::forward<R>(r));
+    }
+
+    template <typename... Others>
+    friend constexpr pipeline<Steps..., Others...> operator|(
+        pipeline lhs,
+        pipeline<Others...> rhs) {
+        return std::move(lhs).concat(std::move(rhs));
+    }
+
+    template <typename R>
+        requires detail::option_or_result<R>
+    friend constexpr auto operator|(R&& r, const pipeline& p) {
+        return p(std::forward<R>(r));
+    }
+};
+
+/// @brief A pipeline step that passes the value to `f`, which returns an
+/// `option` or `result`, like `and_then`
+template <typename F>
+constexpr auto then(F&& f) {
+    return detail::make_pipeline<detail::pipeline_op::then>(std::forward<F>(f));
+}
+
+/// @brief A pipeline step that replaces the value with the result of `f`,
+/// like `transform`
+template <typename F>
+constexpr auto map(F&& f) {
+    return detail::make_pipeline<detail::pipeline_op::map>(std::forward<F>(f));
+}
+
+/// @brief A pipeline step that passes the error to `f`, which returns an
+/// `option` or `result`, like the `or_else` member function
+///
+/// @details
+/// For an empty `option`, `f` is called without arguments.
+template <typename F>
+constexpr auto or_else(F&& f) {
+    return detail::make_pipeline<detail::pipeline_op::or_else>(
+        std::forward<F>(f));
+}
+
+} // namespace jac
+
+#endif
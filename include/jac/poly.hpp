@@ -0,0 +1,225 @@
+#ifndef JAC_POLY_HPP
+#define JAC_POLY_HPP
+
+/// @file
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <jac/relocate.hpp>
+#include <jac/types.hpp>
+
+namespace jac {
+
+/// @brief A polymorphic value that stores small objects inline
+///
+/// @details
+/// `poly` holds an object of any copyable type derived from `Base`, and
+/// copying a `poly` copies the object, so a `std::vector<jac::poly<Base>>`
+/// behaves like a vector of values rather than of pointers. An object that
+/// is at most `Size` bytes, not overaligned and nothrow move constructible is
+/// stored in a buffer inside the `poly`, which keeps a vector of them in one
+/// contiguous allocation. Larger objects are allocated on the heap.
+///
+/// Accessing the object goes through a stored `Base*` without any extra
+/// indirection, and destroying it uses the virtual destructor of `Base`.
+/// Moving an inline object whose type is trivially relocatable copies the
+/// buffer without calling any function, while other types are moved through
+/// a small per-type table of operations.
+/// ```
+/// std::vector<jac::poly<shape>> shapes;
+/// shapes.emplace_back(circle{1.0});
+/// shapes.emplace_back(std::in_place_type<square>, 2.0);
+///
+/// for (auto& s : shapes) { total += s->area(); }
+/// ```
+template <typename Base, size_t Size = 4 * sizeof(void*)>
+class poly {
+  private:
+    static_assert(std::has_virtual_destructor_v<Base>,
+                  "jac::poly needs a base with a virtual destructor");
+
+    struct operations {
+        void (*copy)(const Base& src, poly& dst);
+        // Null when the object can be relocated by copying its bytes
+        void (*relocate)(std::byte* src, std::byte* dst) noexcept;
+        bool on_heap;
+    };
+
+    template <typename D>
+    static constexpr bool fits_inline =
+        sizeof(D) <= Size && alignof(D) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<D>;
+
+    template <typename D>
+    static void copy_object(const Base& src, poly& dst) {
+        dst.template construct<D>(static_cast<const D&>(src));
+    }
+
+    template <typename D>
+    static void relocate_object(std::byte* src, std::byte* dst) noexcept {
+        relocate(std::launder(reinterpret_cast<D*>(src)),
+                 reinterpret_cast<D*>(dst));
+    }
+
+    template <typename D>
+    static constexpr operations ops_for{
+        &copy_object<D>,
+        fits_inline<D> && !is_trivially_relocatable_v<D> ? &relocate_object<D>
+                                                          : nullptr,
+        !fits_inline<D>,
+    };
+
+    alignas(std::max_align_t) std::byte storage_[Size];
+    Base* ptr_{nullptr};
+    const operations* ops_{nullptr};
+
+    template <typename D, typename... Args>
+    D& construct(Args&&... args) {
+        D* obj;
+        if constexpr (fits_inline<D>) {
+            obj = ::new (static_cast<void*>(storage_))
+                D(std::forward<Args>(args)...);
+        } else {
+            obj = new D(std::forward<Args>(args)...);
+        }
+        ptr_ = obj;
+        ops_ = &ops_for<D>;
+        return *obj;
+    }
+
+    void steal(poly& other) noexcept {
+        if (other.ptr_ == nullptr) { return; }
+        if (other.ops_->on_heap) {
+            ptr_ = other.ptr_;
+        } else {
+            if (other.ops_->relocate != nullptr) {
+                other.ops_->relocate(other.storage_, storage_);
+            } else {
+                std::memcpy(storage_, other.storage_, Size);
+            }
+            // The base subobject is at the same offset in the new buffer
+            auto offset = reinterpret_cast<std::byte*>(other.ptr_) -
+                          other.storage_;
+            ptr_ = std::launder(reinterpret_cast<Base*>(storage_ + offset));
+        }
+        ops_ = std::exchange(other.ops_, nullptr);
+        other.ptr_ = nullptr;
+    }
+
+  public:
+    using element_type = Base;
+
+    /// @brief Checks if an object of type `D` is stored without allocating
+    template <typename D>
+    static constexpr bool is_inline_type = fits_inline<std::decay_t<D>>;
+
+    /// @brief Creates an empty `poly`
+    poly() noexcept = default;
+
+    poly([[maybe_unused]] null_t null) noexcept {}
+
+    template <typename D>
+        requires(std::derived_from<std::decay_t<D>, Base> &&
+                 !std::is_same_v<std::decay_t<D>, poly> &&
+                 std::is_copy_constructible_v<std::decay_t<D>>)
+    poly(D&& value) {
+        construct<std::decay_t<D>>(std::forward<D>(value));
+    }
+
+    template <typename D, typename... Args>
+        requires(std::derived_from<D, Base> && std::is_copy_constructible_v<D>)
+    explicit poly([[maybe_unused]] std::in_place_type_t<D> type,
+                  Args&&... args) {
+        construct<D>(std::forward<Args>(args)...);
+    }
+
+    poly(const poly& other) {
+        if (other.ptr_ != nullptr) { other.ops_->copy(*other.ptr_, *this); }
+    }
+
+    poly(poly&& other) noexcept { steal(other); }
+
+    ~poly() { reset(); }
+
+    poly& operator=(const poly& other) {
+        if (this != &other) {
+            poly tmp(other);
+            reset();
+            steal(tmp);
+        }
+        return *this;
+    }
+
+    poly& operator=(poly&& other) noexcept {
+        if (this != &other) {
+            reset();
+            steal(other);
+        }
+        return *this;
+    }
+
+    poly& operator=([[maybe_unused]] null_t null) noexcept {
+        reset();
+        return *this;
+    }
+
+    /// @brief Replaces the object with a `D` constructed from `args`
+    template <typename D, typename... Args>
+        requires(std::derived_from<D, Base> && std::is_copy_constructible_v<D>)
+    D& emplace(Args&&... args) {
+        reset();
+        return construct<D>(std::forward<Args>(args)...);
+    }
+
+    /// @brief Destroys the object, leaving the `poly` empty
+    void reset() noexcept {
+        if (ptr_ == nullptr) { return; }
+        if (ops_->on_heap) {
+            delete ptr_;
+        } else {
+            std::destroy_at(ptr_);
+        }
+        ptr_ = nullptr;
+        ops_ = nullptr;
+    }
+
+    bool has_value() const noexcept { return ptr_ != nullptr; }
+
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    /// @brief Checks if the object is stored in the inline buffer
+    bool is_inline() const noexcept {
+        return ptr_ != nullptr && !ops_->on_heap;
+    }
+
+    Base* get() noexcept { return ptr_; }
+
+    const Base* get() const noexcept { return ptr_; }
+
+    Base& operator*() noexcept { return *ptr_; }
+
+    const Base& operator*() const noexcept { return *ptr_; }
+
+    Base* operator->() noexcept { return ptr_; }
+
+    const Base* operator->() const noexcept { return ptr_; }
+
+    void swap(poly& other) noexcept {
+        poly tmp(std::move(other));
+        other.steal(*this);
+        steal(tmp);
+    }
+
+    friend void swap(poly& lhs, poly& rhs) noexcept { lhs.swap(rhs); }
+};
+
+} // namespace jac
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef JAC_RELOCATE_HPP
+#define JAC_RELOCATE_HPP
+
+/// @file
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace jac {
+
+namespace detail {
+
+template <typename T>
+struct relocatable_opt_in : std::false_type {};
+
+template <typename T>
+    requires requires { typename T::trivially_relocatable; }
+struct relocatable_opt_in<T>
+    : std::bool_constant<T::trivially_relocatable::value> {};
+
+} // namespace detail
+
+/// @brief Trait indicating that a type can be relocated with `memcpy`
+///
+/// @details
+/// Relocating an object means move constructing a new object from it and
+/// then destroying the original. For a trivially relocatable type this pair
+/// of operations is equivalent to copying the object's bytes, even when its
+/// move constructor or destructor is not trivial, as is the case for
+/// `std::unique_ptr` with the default deleter. It is not the case for
+/// strings that point into their own inline buffer, like the `std::string`
+/// of libstdc++.
+///
+/// The trait is true for types that are trivially move constructible and
+/// trivially destructible, and for `std::unique_ptr<T>`. Other types can opt
+/// in either by specializing `jac::is_trivially_relocatable`, or by declaring
+/// a member type named `trivially_relocatable` that is `std::true_type`.
+/// ```
+/// struct my_type {
+///     using trivially_relocatable = std::true_type;
+///     std::unique_ptr<int> ptr;
+/// };
+/// ```
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<(std::is_trivially_move_constructible_v<T> &&
+                          std::is_trivially_destructible_v<T>) ||
+                         detail::relocatable_opt_in<T>::value> {};
+
+template <typename T, size_t N>
+struct is_trivially_relocatable<T[N]> : is_trivially_relocatable<T> {};
+
+template <typename T>
+struct is_trivially_relocatable<const T> : is_trivially_relocatable<T> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T>>>
+    : std::true_type {};
+
+template <typename T>
+static inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+/// @brief Relocates the object at `src` into the uninitialized storage `dst`
+///
+/// @details
+/// After this call, `src` no longer holds an object and `dst` holds the
+/// object previously at `src`.
+template <typename T>
+constexpr T* relocate(T* src, T* dst) noexcept(
+    is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                        sizeof(T));
+            return std::launder(dst);
+        }
+    }
+    std::construct_at(dst, std::move(*src));
+    std::destroy_at(src);
+    return dst;
+}
+
+/// @brief Relocates `n` objects starting at `first` into the uninitialized
+/// storage starting at `d_first`
+///
+/// @details
+/// When `T` is trivially relocatable or nothrow move constructible, the
+/// source and destination ranges may overlap as long as `d_first` is not
+/// after `first`. Otherwise every object is moved before any is destroyed, so
+/// the ranges must not overlap. Returns a pointer one past the last relocated
+/// object in the destination range.
+template <typename T>
+constexpr T* uninitialized_relocate_n(T* first, size_t n, T* d_first) noexcept(
+    is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            if (n != 0) {
+                std::memmove(static_cast<void*>(d_first),
+                             static_cast<const void*>(first), n * sizeof(T));
+            }
+            return d_first + n;
+        }
+    }
+    if constexpr (std::is_nothrow_move_constructible_v<T>) {
+        for (size_t i = 0; i < n; ++i) { relocate(first + i, d_first + i); }
+        return d_first + n;
+    } else {
+        // A throwing move could leave both ranges partially populated, so
+        // move everything first and only then destroy the sources. This is
+        // why the ranges must not overlap here.
+        auto ret = std::uninitialized_move_n(first, n, d_first).second;
+        std::destroy_n(first, n);
+        return ret;
+    }
+}
+
+/// @brief Relocates the objects in `[first, last)` into the uninitialized
+/// storage starting at `d_first`
+///
+/// @copydetails uninitialized_relocate_n
+template <typename T>
+constexpr T* uninitialized_relocate(T* first, T* last, T* d_first) noexcept(
+    is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+    return uninitialized_relocate_n(first, static_cast<size_t>(last - first),
+                                    d_first);
+}
+
+/// @brief Relocates the objects in `[first, last)` into the uninitialized
+/// storage ending at `d_last`, starting with the last object
+///
+/// @details
+/// The source and destination ranges may overlap as long as `d_last` is not
+/// before `last`, which makes this suitable for shifting objects towards the
+/// end of a buffer. Returns a pointer to the first relocated object in the
+/// destination range.
+template <typename T>
+constexpr T* uninitialized_relocate_backward(T* first, T* last, T* d_last) {
+    static_assert(is_trivially_relocatable_v<T> ||
+                      std::is_nothrow_move_constructible_v<T>,
+                  "overlapping relocation requires a non-throwing move");
+    auto n = static_cast<size_t>(last - first);
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            if (n != 0) {
+                std::memmove(static_cast<void*>(d_last - n),
+                             static_cast<const void*>(first), n * sizeof(T));
+            }
+            return d_last - n;
+        }
+    }
+    while (last != first) { relocate(--last, --d_last); }
+    return d_last;
+}
+
+} // namespace jac
+
+#endif
@@ -3,15 +3,22 @@
 
 /// @file
 
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <system_error>
-#include <variant>
+#include <type_traits>
+#include <utility>
 
 #include <jac/holder.hpp>
 #include <jac/macros.hpp>
+#include <jac/relocate.hpp>
+#include <jac/tagged_ptr.hpp>
 #include <jac/types.hpp>
 #include <jac/utils.hpp>
+#include <jac/variant.hpp>
 
 namespace jac {
 
@@ -49,14 +56,188 @@ class bad_result_access : public std::exception {
     }
 };
 
+namespace detail {
+
+// The storage of a result, where index 0 holds the value, 1 the error, and 2
+// nothing, which is only seen while a result is being constructed
+template <typename T, typename E>
+class result_variant {
+  private:
+    variant<holder<T>, holder<E>, void> value_;
+
+  public:
+    using error_reference = typename holder<E>::reference;
+    using error_const_reference = typename holder<E>::const_reference;
+    using error_rvalue_reference = typename holder<E>::rvalue_reference;
+    using error_const_rvalue_reference =
+        typename holder<E>::const_rvalue_reference;
+
+    constexpr result_variant() = default;
+
+    template <size_t I, typename... Args>
+    explicit constexpr result_variant(std::in_place_index_t<I> index,
+                                      Args&&... args)
+        : value_(index, std::forward<Args>(args)...) {}
+
+    constexpr size_t index() const noexcept { return value_.index(); }
+
+    template <size_t I>
+    constexpr auto& get() & noexcept {
+        return *get_if<I>(&value_);
+    }
+
+    template <size_t I>
+    constexpr const auto& get() const& noexcept {
+        return *get_if<I>(&value_);
+    }
+
+    template <size_t I>
+    constexpr auto&& get() && noexcept {
+        return std::move(*get_if<I>(&value_));
+    }
+
+    template <size_t I>
+    constexpr const auto&& get() const&& noexcept {
+        return std::move(*get_if<I>(&value_));
+    }
+
+    template <size_t I, typename... Args>
+    constexpr auto& emplace(Args&&... args) {
+        return value_.template emplace<I>(std::forward<Args>(args)...);
+    }
+
+    // Assigns to the alternative if it is active, and constructs it otherwise
+    template <size_t I, typename U>
+    constexpr void assign(U&& value) {
+        if (value_.index() == I) {
+            *get_if<I>(&value_) = std::forward<U>(value);
+        } else {
+            value_.template emplace<I>(std::in_place, std::forward<U>(value));
+        }
+    }
+
+    constexpr void swap(result_variant& other) { value_.swap(other.value_); }
+};
+
+// A result<T&, E> with a small integral or enum error stored as a single
+// tagged pointer, with the state in the two low bits of the tag and the
+// error in the rest
+template <typename T, typename E>
+class packed_result;
+
+template <typename T, typename E>
+class packed_result<T&, E> {
+  private:
+    using raw_error = std::make_unsigned_t<
+        typename std::conditional_t<std::is_enum_v<E>,
+                                    std::underlying_type<E>,
+                                    std::type_identity<E>>::type>;
+
+    tagged_ptr<T, 2 + 8 * sizeof(E)> ptr_;
+
+    static uintptr_t error_tag(E err) noexcept {
+        return uintptr_t(static_cast<raw_error>(err)) << 2 | 1;
+    }
+
+  public:
+    using error_reference = E;
+    using error_const_reference = E;
+    using error_rvalue_reference = E;
+    using error_const_rvalue_reference = E;
+
+    // Like holder<T&>, a default constructed value refers to nothing
+    constexpr packed_result() = default;
+
+    template <typename... Args>
+    explicit packed_result([[maybe_unused]] std::in_place_index_t<0> index,
+                           Args&&... args)
+        : ptr_(holder<T&>(std::forward<Args>(args)...).operator->()) {}
+
+    template <typename... Args>
+    explicit packed_result([[maybe_unused]] std::in_place_index_t<1> index,
+                           Args&&... args)
+        : ptr_(nullptr, error_tag(*holder<E>(std::forward<Args>(args)...))) {}
+
+    explicit packed_result([[maybe_unused]] std::in_place_index_t<2> index)
+        : ptr_(nullptr, 2) {}
+
+    constexpr size_t index() const noexcept { return ptr_.tag() & 3; }
+
+    template <size_t I>
+    auto get() const noexcept {
+        if constexpr (I == 0) {
+            return holder<T&>(*ptr_);
+        } else {
+            return holder<E>(
+                static_cast<E>(static_cast<raw_error>(ptr_.tag() >> 2)));
+        }
+    }
+
+    template <size_t I, typename... Args>
+    auto emplace(Args&&... args) {
+        *this = packed_result(std::in_place_index<I>,
+                              std::forward<Args>(args)...);
+        return get<I>();
+    }
+
+    template <size_t I, typename U>
+    void assign(U&& value) {
+        if constexpr (I == 0) {
+            // Assigns through the reference, as holder<T&> does
+            if (index() == 0) {
+                get<0>() = std::forward<U>(value);
+                return;
+            }
+        }
+        emplace<I>(std::in_place, std::forward<U>(value));
+    }
+
+    void swap(packed_result& other) noexcept { std::swap(ptr_, other.ptr_); }
+};
+
+// Errors of one byte, other than bool, whose values fit in the tag
+template <typename E>
+inline constexpr bool packable_error = false;
+
+template <typename E>
+    requires std::is_integral_v<E>
+inline constexpr bool packable_error<E> =
+    sizeof(E) == 1 && !std::is_same_v<E, bool>;
+
+template <typename E>
+    requires std::is_enum_v<E>
+inline constexpr bool packable_error<E> =
+    packable_error<std::underlying_type_t<E>>;
+
+template <typename T, typename E>
+inline constexpr bool packs_result = false;
+
+template <typename T, typename E>
+    requires(packable_error<E> && !std::is_const_v<E> &&
+             !std::is_volatile_v<E>)
+inline constexpr bool packs_result<T&, E> =
+    2 + 8 * sizeof(E) <=
+    std::countr_zero(alignof(T)) + JAC_POINTER_HIGH_BITS;
+
+template <typename T, typename E>
+using result_storage = std::conditional_t<packs_result<T, E>,
+                                          packed_result<T, E>,
+                                          result_variant<T, E>>;
+
+} // namespace detail
+
 /// @brief Type safe union of a success value and an error value
 ///
 /// jac::result is modelled after `std::expected`, but it works with references
 /// and `void` as both the success or error types.
+///
+/// A `result<T&, E>` whose error is an integral or enum type of one byte is
+/// stored as a single tagged pointer, so it is returned in one register. Its
+/// `error()` returns the error by value rather than by reference.
 template <typename T, typename E = std::error_code>
 class result {
   private:
-    std::variant<holder<T>, holder<E>, std::monostate> value_;
+    detail::result_storage<T, E> value_;
 
   public:
     using value_type = typename holder<T>::value_type;
@@ -68,11 +249,14 @@ class result {
     using const_pointer = typename holder<T>::const_pointer;
 
     using error_type = typename holder<E>::value_type;
-    using error_reference = typename holder<E>::reference;
-    using error_const_reference = typename holder<E>::const_reference;
-    using error_rvalue_reference = typename holder<E>::rvalue_reference;
+    using error_reference =
+        typename detail::result_storage<T, E>::error_reference;
+    using error_const_reference =
+        typename detail::result_storage<T, E>::error_const_reference;
+    using error_rvalue_reference =
+        typename detail::result_storage<T, E>::error_rvalue_reference;
     using error_const_rvalue_reference =
-        typename holder<E>::const_rvalue_reference;
+        typename detail::result_storage<T, E>::error_const_rvalue_reference;
     using error_pointer = typename holder<E>::pointer;
     using error_const_pointer = typename holder<E>::const_pointer;
 
@@ -227,11 +411,7 @@ class result {
                  (!std::is_same_v<std::decay_t<U>, value_type> ||
                   !std::is_scalar_v<value_type>))
     constexpr result& operator=(U&& value) {
-        if (value_.index() == 0) {
-            *std::get_if<0>(value_) = std::forward<U>(value);
-        } else {
-            value_.template emplace<0>(std::in_place, std::forward<U>(value));
-        }
+        value_.template assign<0>(std::forward<U>(value));
         return *this;
     }
 
@@ -253,11 +433,7 @@ class result {
                  !std::is_assignable_v<value_type, error<V> &&> &&
                  !std::is_assignable_v<value_type, const error<V> &&>)
     constexpr result& operator=(const error<V>& err) {
-        if (value_.index() == 1) {
-            *std::get_if<1>(value_) = *err;
-        } else {
-            value_.template emplace<1>(std::in_place, *err);
-        }
+        value_.template assign<1>(*err);
         return *this;
     }
 
@@ -279,11 +455,7 @@ class result {
                  !std::is_assignable_v<value_type, error<V> &&> &&
                  !std::is_assignable_v<value_type, const error<V> &&>)
     constexpr result& operator=(error<V>&& err) {
-        if (value_.index() == 1) {
-            *std::get_if<1>(value_) = *std::move(err);
-        } else {
-            value_.template emplace<1>(std::in_place, *std::move(err));
-        }
+        value_.template assign<1>(*std::move(err));
         return *this;
     }
 
@@ -302,17 +474,9 @@ class result {
                  !std::is_assignable_v<value_type, const result<U, V> &&>)
     constexpr result& operator=(const result<U, V>& other) {
         if (other.has_value()) {
-            if (value_.index() == 0) {
-                *std::get_if<0>(value_) = *other;
-            } else {
-                value_.template emplace<0>(std::in_place, *other);
-            }
+            value_.template assign<0>(*other);
         } else {
-            if (value_.index() == 1) {
-                *std::get_if<1>(value_) = other.error();
-            } else {
-                value_.template emplace<1>(std::in_place, other.error());
-            }
+            value_.template assign<1>(other.error());
         }
         return *this;
     }
@@ -332,18 +496,9 @@ class result {
                  !std::is_assignable_v<value_type, const result<U, V> &&>)
     constexpr result& operator=(result<U, V>&& other) {
         if (other.has_value()) {
-            if (value_.index() == 0) {
-                *std::get_if<0>(value_) = *std::move(other);
-            } else {
-                value_.template emplace<0>(std::in_place, *std::move(other));
-            }
+            value_.template assign<0>(*std::move(other));
         } else {
-            if (value_.index() == 1) {
-                *std::get_if<1>(value_) = std::move(other).error();
-            } else {
-                value_.template emplace<1>(std::in_place,
-                                           std::move(other).error());
-            }
+            value_.template assign<1>(std::move(other).error());
         }
         return *this;
     }
@@ -353,67 +508,63 @@ class result {
     constexpr operator bool() const noexcept { return value_.index() == 0; }
 
     constexpr reference value() & {
-        auto ptr = &*std::get_if<0>(value_);
-        if (ptr == nullptr) { throw bad_result_access(); }
-        return *ptr;
+        if (!has_value()) { throw bad_result_access(); }
+        return *value_.template get<0>();
     }
 
     constexpr const_reference value() const& {
-        auto ptr = &*std::get_if<0>(value_);
-        if (ptr == nullptr) { throw bad_result_access(); }
-        return *ptr;
+        if (!has_value()) { throw bad_result_access(); }
+        return *value_.template get<0>();
     }
 
     constexpr rvalue_reference value() && {
-        auto ptr = &*std::get_if<0>(value_);
-        if (ptr == nullptr) { throw bad_result_access(); }
-        return std::move(*ptr);
+        if (!has_value()) { throw bad_result_access(); }
+        return *std::move(value_).template get<0>();
     }
 
     constexpr const_rvalue_reference value() const&& {
-        auto ptr = &*std::get_if<0>(value_);
-        if (ptr == nullptr) { throw bad_result_access(); }
-        return std::move(*ptr);
+        if (!has_value()) { throw bad_result_access(); }
+        return *std::move(value_).template get<0>();
     }
 
     constexpr error_reference error() & noexcept {
-        return **std::get_if<1>(value_);
+        return *value_.template get<1>();
     }
 
     constexpr error_const_reference error() const& noexcept {
-        return **std::get_if<1>(value_);
+        return *value_.template get<1>();
     }
 
     constexpr error_rvalue_reference error() && {
-        return *std::move(*std::get_if<1>(value_));
+        return *std::move(value_).template get<1>();
     }
 
     constexpr error_const_rvalue_reference error() const&& {
-        return *std::move(*std::get_if<1>(value_));
+        return *std::move(value_).template get<1>();
     }
 
     constexpr reference operator*() & noexcept {
-        return **std::get_if<0>(value_);
+        return *value_.template get<0>();
     }
 
     constexpr const_reference operator*() const& noexcept {
-        return **std::get_if<0>(value_);
+        return *value_.template get<0>();
     }
 
     constexpr rvalue_reference operator*() && {
-        return *std::move(*std::get_if<0>(value_));
+        return *std::move(value_).template get<0>();
     }
 
     constexpr const_rvalue_reference operator*() const&& {
-        return *std::move(*std::get_if<0>(value_));
+        return *std::move(value_).template get<0>();
     }
 
     constexpr pointer operator->() noexcept {
-        return &**std::get_if<0>(value_);
+        return &*value_.template get<0>();
     }
 
     constexpr const_pointer operator->() const noexcept {
-        return &**std::get_if<0>(value_);
+        return &*value_.template get<0>();
     }
 
     template <typename U>
@@ -627,27 +778,31 @@ class result {
 
     template <typename... Args>
     constexpr reference emplace(Args&&... args) {
-        return value_.template emplace<0>(std::forward<Args>(args)...);
+        return *value_.template emplace<0>(std::in_place,
+                                             std::forward<Args>(args)...);
     }
 
     template <typename U, typename... Args>
     constexpr reference emplace(std::initializer_list<U> ilist,
                                 Args&&... args) {
-        return value_.template emplace<0>(ilist, std::forward<Args>(args)...);
+        return *value_.template emplace<0>(
+            std::in_place, ilist, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
     constexpr error_reference emplace_error(Args&&... args) {
-        return value_.template emplace<1>(std::forward<Args>(args)...);
+        return *value_.template emplace<1>(std::in_place,
+                                             std::forward<Args>(args)...);
     }
 
     template <typename U, typename... Args>
     constexpr error_reference emplace_error(std::initializer_list<U> ilist,
                                             Args&&... args) {
-        return value_.template emplace<1>(ilist, std::forward<Args>(args)...);
+        return *value_.template emplace<1>(
+            std::in_place, ilist, std::forward<Args>(args)...);
     }
 
-    constexpr void swap(result& other) { value_.swap(other); }
+    constexpr void swap(result& other) { value_.swap(other.value_); }
 
     constexpr result<reference, error_reference> as_ref() noexcept {
         if (has_value()) {
@@ -668,6 +823,12 @@ class result {
     }
 };
 
+template <typename T, typename E>
+struct is_trivially_relocatable<result<T, E>>
+    : std::bool_constant<
+          is_trivially_relocatable_v<typename result<T, E>::value_type> &&
+          is_trivially_relocatable_v<typename result<T, E>::error_type>> {};
+
 template <typename T, typename E>
 constexpr void swap(result<T, E>& a, result<T, E>& b) {
     a.swap(b);
@@ -703,6 +864,16 @@ constexpr bool operator==(const error<V>& lhs, const result<T, E>& rhs) {
     return !rhs.has_value() && *lhs == rhs.error();
 }
 
+namespace detail {
+
+template <typename T>
+inline constexpr bool is_result_v = false;
+
+template <typename T, typename E>
+inline constexpr bool is_result_v<result<T, E>> = true;
+
+} // namespace detail
+
 } // namespace jac
 
 template <typename E>
@@ -719,9 +890,11 @@ struct std::hash<::jac::error<E>> {
 template <typename T, typename E>
 struct std::hash<::jac::result<T, E>> {
   private:
-    JAC_NO_UNIQ_ADDR std::hash<typename ::jac::result<T, E>::value_type>
+    JAC_NO_UNIQ_ADDR std::hash<
+        std::remove_cvref_t<typename ::jac::result<T, E>::value_type>>
         val_hasher_;
-    JAC_NO_UNIQ_ADDR std::hash<typename ::jac::result<T, E>::error_type>
+    JAC_NO_UNIQ_ADDR std::hash<
+        std::remove_cvref_t<typename ::jac::result<T, E>::error_type>>
         err_hasher_;
     JAC_NO_UNIQ_ADDR std::hash<bool> bool_hasher_;
 
@@ -731,7 +904,7 @@ struct std::hash<::jac::result<T, E>> {
             return ::jac::hash_combine(bool_hasher_(true), val_hasher_(*res));
         } else {
             return ::jac::hash_combine(bool_hasher_(false),
-                                       val_hasher_(res.error()));
+                                       err_hasher_(res.error()));
         }
     }
 };
@@ -0,0 +1,340 @@
+#ifndef JAC_RESULT_VECTOR_HPP
+#define JAC_RESULT_VECTOR_HPP
+
+/// @file
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <jac/holder.hpp>
+#include <jac/relocate.hpp>
+#include <jac/result.hpp>
+
+namespace jac {
+
+namespace detail {
+
+// Growable contiguous storage that relocates its elements on regrowth
+template <typename T>
+class value_column {
+  private:
+    T* data_{nullptr};
+    size_t size_{0};
+    size_t capacity_{0};
+
+    // Relocates the elements into `new_data` and takes ownership of it
+    constexpr void adopt(T* new_data, size_t new_cap) {
+        uninitialized_relocate_n(data_, size_, new_data);
+        if (data_ != nullptr) {
+            std::allocator<T>{}.deallocate(data_, capacity_);
+        }
+        data_ = new_data;
+        capacity_ = new_cap;
+    }
+
+  public:
+    constexpr value_column() = default;
+
+    constexpr value_column(const value_column& other) {
+        if (other.size_ != 0) {
+            auto new_data = std::allocator<T>{}.allocate(other.size_);
+            try {
+                std::uninitialized_copy_n(other.data_, other.size_, new_data);
+            } catch (...) {
+                std::allocator<T>{}.deallocate(new_data, other.size_);
+                throw;
+            }
+            data_ = new_data;
+            size_ = other.size_;
+            capacity_ = other.size_;
+        }
+    }
+
+    constexpr value_column(value_column&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {}
+
+    constexpr ~value_column() {
+        clear();
+        if (data_ != nullptr) {
+            std::allocator<T>{}.deallocate(data_, capacity_);
+        }
+    }
+
+    constexpr value_column& operator=(const value_column& other) {
+        if (this != &other) {
+            value_column tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    constexpr value_column& operator=(value_column&& other) noexcept {
+        value_column tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    constexpr T* data() noexcept { return data_; }
+
+    constexpr const T* data() const noexcept { return data_; }
+
+    constexpr size_t size() const noexcept { return size_; }
+
+    constexpr T& operator[](size_t idx) noexcept { return data_[idx]; }
+
+    constexpr const T& operator[](size_t idx) const noexcept {
+        return data_[idx];
+    }
+
+    constexpr void reserve(size_t n) {
+        if (n > capacity_) {
+            auto new_data = std::allocator<T>{}.allocate(n);
+            try {
+                adopt(new_data, n);
+            } catch (...) {
+                std::allocator<T>{}.deallocate(new_data, n);
+                throw;
+            }
+        }
+    }
+
+    template <typename... Args>
+    constexpr T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            // Construct the new element before relocating the old ones, since
+            // the arguments may refer to existing elements.
+            auto new_cap = capacity_ == 0 ? 8 : capacity_ * 2;
+            auto new_data = std::allocator<T>{}.allocate(new_cap);
+            auto elem = new_data + size_;
+            try {
+                std::construct_at(elem, std::forward<Args>(args)...);
+                try {
+                    adopt(new_data, new_cap);
+                } catch (...) {
+                    std::destroy_at(elem);
+                    throw;
+                }
+            } catch (...) {
+                std::allocator<T>{}.deallocate(new_data, new_cap);
+                throw;
+            }
+        } else {
+            std::construct_at(data_ + size_, std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    constexpr void clear() noexcept {
+        std::destroy_n(data_, size_);
+        size_ = 0;
+    }
+
+    constexpr void swap(value_column& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+};
+
+} // namespace detail
+
+/// @brief A sequence of results stored as separate value and error columns
+///
+/// @details
+/// `result_vector` behaves like a `std::vector<jac::result<T, E>>` that is
+/// optimized for the case where errors are rare. Success values are stored
+/// contiguously in a dense column with no gaps, errors are stored in a sparse
+/// side-table of `(index, error)` entries sorted by row index, and a bitmap
+/// records which rows failed.
+///
+/// Iterating only the successes (`values()`) or only the errors (`errors()`)
+/// walks a single contiguous column and never touches the other. Checking
+/// whether a row succeeded is a single bit test. Random access to a row that
+/// succeeded costs a binary search over the error table, which is cheap when
+/// errors are rare.
+///
+/// Like `jac::result`, `void` may be used for either the success or error
+/// type, in which case `jac::void_t` is stored.
+template <typename T, typename E = std::error_code>
+    requires(!std::is_reference_v<T> && !std::is_reference_v<E>)
+class result_vector {
+  public:
+    using value_type = typename holder<T>::value_type;
+    using reference = typename holder<T>::reference;
+    using const_reference = typename holder<T>::const_reference;
+    using pointer = typename holder<T>::pointer;
+    using const_pointer = typename holder<T>::const_pointer;
+
+    using error_type = typename holder<E>::value_type;
+    using error_reference = typename holder<E>::reference;
+    using error_const_reference = typename holder<E>::const_reference;
+
+    using size_type = size_t;
+
+    /// @brief An entry in the error side-table
+    struct error_entry {
+        size_type index;
+        error_type error;
+    };
+
+  private:
+    static constexpr size_type word_bits = 64;
+
+    detail::value_column<value_type> values_;
+    std::vector<error_entry> errors_;
+    std::vector<uint64_t> failed_;
+    size_type size_{0};
+
+    constexpr void reserve_row() {
+        if (failed_.size() * word_bits == size_) { failed_.push_back(0); }
+    }
+
+    constexpr void commit_row(bool failed) noexcept {
+        if (failed) {
+            failed_[size_ / word_bits] |= uint64_t{1} << (size_ % word_bits);
+        }
+        ++size_;
+    }
+
+    // Number of errors stored for rows before `row`
+    constexpr size_type error_rank(size_type row) const noexcept {
+        auto it = std::lower_bound(
+            errors_.begin(), errors_.end(), row,
+            [](const error_entry& entry, size_type idx) {
+                return entry.index < idx;
+            });
+        return static_cast<size_type>(it - errors_.begin());
+    }
+
+  public:
+    constexpr result_vector() = default;
+
+    constexpr result_vector(const result_vector&) = default;
+
+    constexpr result_vector(result_vector&&) = default;
+
+    constexpr ~result_vector() = default;
+
+    constexpr result_vector& operator=(const result_vector&) = default;
+
+    constexpr result_vector& operator=(result_vector&&) = default;
+
+    constexpr size_type size() const noexcept { return size_; }
+
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Number of rows holding a success value
+    constexpr size_type value_count() const noexcept { return values_.size(); }
+
+    /// @brief Number of rows holding an error
+    constexpr size_type error_count() const noexcept { return errors_.size(); }
+
+    constexpr void reserve(size_type n) {
+        values_.reserve(n);
+        failed_.reserve((n + word_bits - 1) / word_bits);
+    }
+
+    constexpr void clear() noexcept {
+        values_.clear();
+        errors_.clear();
+        failed_.clear();
+        size_ = 0;
+    }
+
+    /// @brief Checks if the row at `row` holds a success value
+    constexpr bool has_value(size_type row) const noexcept {
+        return ((failed_[row / word_bits] >> (row % word_bits)) & 1) == 0;
+    }
+
+    template <typename... Args>
+    constexpr reference emplace_back(Args&&... args) {
+        reserve_row();
+        auto& ret = values_.emplace_back(std::forward<Args>(args)...);
+        commit_row(false);
+        return ret;
+    }
+
+    template <typename... Args>
+    constexpr error_reference emplace_back_error(Args&&... args) {
+        reserve_row();
+        auto& ret = errors_.emplace_back(
+            error_entry{size_, error_type(std::forward<Args>(args)...)});
+        commit_row(true);
+        return ret.error;
+    }
+
+    template <typename U, typename V>
+    constexpr void push_back(const result<U, V>& res) {
+        if (res.has_value()) {
+            emplace_back(*res);
+        } else {
+            emplace_back_error(res.error());
+        }
+    }
+
+    template <typename U, typename V>
+    constexpr void push_back(result<U, V>&& res) {
+        if (res.has_value()) {
+            emplace_back(*std::move(res));
+        } else {
+            emplace_back_error(std::move(res).error());
+        }
+    }
+
+    constexpr result<reference, error_reference> operator[](size_type row) {
+        if (has_value(row)) {
+            return result<reference, error_reference>(
+                values_[row - error_rank(row)]);
+        } else {
+            return result<reference, error_reference>(
+                in_place_error, errors_[error_rank(row)].error);
+        }
+    }
+
+    constexpr result<const_reference, error_const_reference> operator[](
+        size_type row) const {
+        if (has_value(row)) {
+            return result<const_reference, error_const_reference>(
+                values_[row - error_rank(row)]);
+        } else {
+            return result<const_reference, error_const_reference>(
+                in_place_error, errors_[error_rank(row)].error);
+        }
+    }
+
+    /// @brief The dense column of success values, in row order
+    constexpr std::span<value_type> values() noexcept {
+        return {values_.data(), values_.size()};
+    }
+
+    /// @brief The dense column of success values, in row order
+    constexpr std::span<const value_type> values() const noexcept {
+        return {values_.data(), values_.size()};
+    }
+
+    /// @brief The error side-table, sorted by row index
+    constexpr std::span<const error_entry> errors() const noexcept {
+        return errors_;
+    }
+
+    constexpr void swap(result_vector& other) noexcept {
+        values_.swap(other.values_);
+        errors_.swap(other.errors_);
+        failed_.swap(other.failed_);
+        std::swap(size_, other.size_);
+    }
+
+    friend constexpr void swap(result_vector& a, result_vector& b) noexcept {
+        a.swap(b);
+    }
+};
+
+} // namespace jac
+
+#endif
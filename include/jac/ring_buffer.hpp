@@ -0,0 +1,508 @@
+#ifndef JAC_RING_BUFFER_HPP
+#define JAC_RING_BUFFER_HPP
+
+/// @file
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include <jac/maybe_uninit.hpp>
+#include <jac/option.hpp>
+#include <jac/relocate.hpp>
+
+namespace jac {
+
+namespace detail {
+
+template <typename T, size_t N>
+class ring_storage {
+  private:
+    maybe_uninit<T[N]> slots_;
+
+  public:
+    constexpr ring_storage() = default;
+
+    explicit constexpr ring_storage([[maybe_unused]] size_t capacity) {}
+
+    // Copying and moving only set up empty storage. The owning ring_buffer
+    // is responsible for the elements.
+    constexpr ring_storage([[maybe_unused]] const ring_storage& other) {}
+
+    constexpr ring_storage& operator=(
+        [[maybe_unused]] const ring_storage& other) {
+        return *this;
+    }
+
+    constexpr T* data() noexcept { return slots_.value(); }
+
+    constexpr const T* data() const noexcept { return slots_.value(); }
+
+    static constexpr size_t capacity() noexcept { return N; }
+
+    static constexpr bool steals_on_move = false;
+
+    constexpr void swap([[maybe_unused]] ring_storage& other) noexcept {}
+};
+
+template <typename T>
+class ring_storage<T, std::dynamic_extent> {
+  private:
+    T* data_{nullptr};
+    size_t capacity_{0};
+
+  public:
+    constexpr ring_storage() = default;
+
+    explicit constexpr ring_storage(size_t capacity)
+        : data_(capacity == 0 ? nullptr
+                              : std::allocator<T>{}.allocate(capacity)),
+          capacity_(capacity) {}
+
+    constexpr ring_storage(const ring_storage& other)
+        : ring_storage(other.capacity_) {}
+
+    constexpr ring_storage(ring_storage&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)) {}
+
+    constexpr ~ring_storage() {
+        if (data_ != nullptr) {
+            std::allocator<T>{}.deallocate(data_, capacity_);
+        }
+    }
+
+    constexpr ring_storage& operator=(ring_storage other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    constexpr T* data() noexcept { return data_; }
+
+    constexpr const T* data() const noexcept { return data_; }
+
+    constexpr size_t capacity() const noexcept { return capacity_; }
+
+    static constexpr bool steals_on_move = true;
+
+    constexpr void swap(ring_storage& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(capacity_, other.capacity_);
+    }
+};
+
+} // namespace detail
+
+/// @brief A fixed-capacity double-ended queue stored in a single ring of slots
+///
+/// @details
+/// `ring_buffer` keeps its elements in one contiguous array of uninitialized
+/// slots that wraps around. The capacity is either fixed at compile time
+/// through `Capacity`, in which case the slots are stored inline, or given at
+/// run time when `Capacity` is `std::dynamic_extent`, in which case the slots
+/// are allocated once on construction. The buffer never reallocates.
+///
+/// Since the elements occupy at most two contiguous segments of the slot
+/// array, `as_spans()` exposes them directly for bulk processing, such as
+/// `memcpy`, `writev`, or vectorized aggregation.
+///
+/// When the buffer is full, `try_push_back` and `try_push_front` reject the
+/// new element, while `push_back_overwrite` and `push_front_overwrite` evict
+/// the element at the opposite end and return it.
+template <typename T, size_t Capacity = std::dynamic_extent>
+class ring_buffer {
+  private:
+    detail::ring_storage<T, Capacity> storage_;
+    size_t head_{0};
+    size_t size_{0};
+
+    constexpr size_t wrap(size_t idx) const noexcept {
+        auto cap = storage_.capacity();
+        return idx >= cap ? idx - cap : idx;
+    }
+
+    constexpr T* slot(size_t logical) noexcept {
+        return storage_.data() + wrap(head_ + logical);
+    }
+
+    constexpr const T* slot(size_t logical) const noexcept {
+        return storage_.data() + wrap(head_ + logical);
+    }
+
+    constexpr void steal(ring_buffer& other) {
+        auto [first, second] = other.as_spans();
+        auto dst = uninitialized_relocate_n(first.data(), first.size(),
+                                            storage_.data());
+        uninitialized_relocate_n(second.data(), second.size(), dst);
+        head_ = 0;
+        size_ = std::exchange(other.size_, 0);
+        other.head_ = 0;
+    }
+
+    template <bool Const>
+    class basic_iterator {
+      private:
+        friend class ring_buffer;
+
+        using buffer_type =
+            std::conditional_t<Const, const ring_buffer, ring_buffer>;
+
+        buffer_type* buf_{nullptr};
+        size_t idx_{0};
+
+        constexpr basic_iterator(buffer_type* buf, size_t idx) noexcept
+            : buf_(buf), idx_(idx) {}
+
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = ptrdiff_t;
+        using value_type = T;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+
+        constexpr basic_iterator() = default;
+
+        template <bool C = Const>
+            requires(C)
+        constexpr basic_iterator(const basic_iterator<false>& other) noexcept
+            : buf_(other.buf_), idx_(other.idx_) {}
+
+        constexpr reference operator*() const noexcept {
+            return *buf_->slot(idx_);
+        }
+
+        constexpr pointer operator->() const noexcept {
+            return buf_->slot(idx_);
+        }
+
+        constexpr reference operator[](difference_type n) const noexcept {
+            return *buf_->slot(static_cast<size_t>(
+                static_cast<difference_type>(idx_) + n));
+        }
+
+        constexpr basic_iterator& operator++() noexcept {
+            ++idx_;
+            return *this;
+        }
+
+        constexpr basic_iterator operator++(int) noexcept {
+            auto ret = *this;
+            ++idx_;
+            return ret;
+        }
+
+        constexpr basic_iterator& operator--() noexcept {
+            --idx_;
+            return *this;
+        }
+
+        constexpr basic_iterator operator--(int) noexcept {
+            auto ret = *this;
+            --idx_;
+            return ret;
+        }
+
+        constexpr basic_iterator& operator+=(difference_type n) noexcept {
+            idx_ = static_cast<size_t>(static_cast<difference_type>(idx_) + n);
+            return *this;
+        }
+
+        constexpr basic_iterator& operator-=(difference_type n) noexcept {
+            return *this += -n;
+        }
+
+        friend constexpr basic_iterator operator+(basic_iterator it,
+                                                  difference_type n) noexcept {
+            return it += n;
+        }
+
+        friend constexpr basic_iterator operator+(difference_type n,
+                                                  basic_iterator it) noexcept {
+            return it += n;
+        }
+
+        friend constexpr basic_iterator operator-(basic_iterator it,
+                                                  difference_type n) noexcept {
+            return it -= n;
+        }
+
+        friend constexpr difference_type operator-(
+            const basic_iterator& lhs,
+            const basic_iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.idx_) -
+                   static_cast<difference_type>(rhs.idx_);
+        }
+
+        friend constexpr bool operator==(const basic_iterator& lhs,
+                                         const basic_iterator& rhs) noexcept {
+            return lhs.idx_ == rhs.idx_;
+        }
+
+        friend constexpr auto operator<=>(const basic_iterator& lhs,
+                                          const basic_iterator& rhs) noexcept {
+            return lhs.idx_ <=> rhs.idx_;
+        }
+    };
+
+  public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    constexpr ring_buffer()
+        requires(Capacity != std::dynamic_extent)
+    = default;
+
+    explicit constexpr ring_buffer(size_type capacity)
+        requires(Capacity == std::dynamic_extent)
+        : storage_(capacity) {}
+
+    constexpr ring_buffer(const ring_buffer& other) : storage_(other.storage_) {
+        try {
+            for (const auto& value : other) {
+                std::construct_at(storage_.data() + size_, value);
+                ++size_;
+            }
+        } catch (...) {
+            // The destructor does not run for a partially constructed buffer
+            clear();
+            throw;
+        }
+    }
+
+    constexpr ring_buffer(ring_buffer&& other) noexcept(
+        Capacity == std::dynamic_extent || is_trivially_relocatable_v<T> ||
+        std::is_nothrow_move_constructible_v<T>)
+        : storage_(std::move(other.storage_)) {
+        if constexpr (decltype(storage_)::steals_on_move) {
+            head_ = std::exchange(other.head_, 0);
+            size_ = std::exchange(other.size_, 0);
+        } else {
+            steal(other);
+        }
+    }
+
+    constexpr ~ring_buffer() { clear(); }
+
+    constexpr ring_buffer& operator=(const ring_buffer& other) {
+        if (this != &other) {
+            clear();
+            if constexpr (Capacity == std::dynamic_extent) {
+                storage_ = other.storage_;
+            }
+            for (const auto& value : other) {
+                std::construct_at(storage_.data() + size_, value);
+                ++size_;
+            }
+        }
+        return *this;
+    }
+
+    constexpr ring_buffer& operator=(ring_buffer&& other) noexcept(
+        Capacity == std::dynamic_extent || is_trivially_relocatable_v<T> ||
+        std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            if constexpr (decltype(storage_)::steals_on_move) {
+                storage_.swap(other.storage_);
+                head_ = std::exchange(other.head_, 0);
+                size_ = std::exchange(other.size_, 0);
+            } else {
+                steal(other);
+            }
+        }
+        return *this;
+    }
+
+    constexpr size_type size() const noexcept { return size_; }
+
+    constexpr size_type capacity() const noexcept {
+        return storage_.capacity();
+    }
+
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr bool full() const noexcept { return size_ == capacity(); }
+
+    constexpr void clear() noexcept {
+        auto [first, second] = as_spans();
+        std::destroy(first.begin(), first.end());
+        std::destroy(second.begin(), second.end());
+        head_ = 0;
+        size_ = 0;
+    }
+
+    /// @brief Gets the elements as two contiguous segments, in order
+    ///
+    /// @details
+    /// The second segment is empty unless the elements wrap around the end of
+    /// the slot array.
+    constexpr std::pair<std::span<T>, std::span<T>> as_spans() noexcept {
+        auto cap = capacity();
+        auto data = storage_.data();
+        if (head_ + size_ <= cap) {
+            return {std::span<T>(data + head_, size_), std::span<T>()};
+        }
+        return {std::span<T>(data + head_, cap - head_),
+                std::span<T>(data, head_ + size_ - cap)};
+    }
+
+    /// @copydoc as_spans
+    constexpr std::pair<std::span<const T>, std::span<const T>> as_spans()
+        const noexcept {
+        auto [first, second] = const_cast<ring_buffer*>(this)->as_spans();
+        return {first, second};
+    }
+
+    constexpr reference operator[](size_type idx) noexcept {
+        return *slot(idx);
+    }
+
+    constexpr const_reference operator[](size_type idx) const noexcept {
+        return *slot(idx);
+    }
+
+    constexpr option<T&> front() noexcept {
+        if (size_ == 0) { return null; }
+        return option<T&>(*slot(0));
+    }
+
+    constexpr option<const T&> front() const noexcept {
+        if (size_ == 0) { return null; }
+        return option<const T&>(*slot(0));
+    }
+
+    constexpr option<T&> back() noexcept {
+        if (size_ == 0) { return null; }
+        return option<T&>(*slot(size_ - 1));
+    }
+
+    constexpr option<const T&> back() const noexcept {
+        if (size_ == 0) { return null; }
+        return option<const T&>(*slot(size_ - 1));
+    }
+
+    /// @brief Constructs an element at the back, unless the buffer is full
+    template <typename... Args>
+    constexpr option<T&> try_emplace_back(Args&&... args) {
+        if (full()) { return null; }
+        auto ptr = std::construct_at(slot(size_), std::forward<Args>(args)...);
+        ++size_;
+        return option<T&>(*ptr);
+    }
+
+    /// @brief Constructs an element at the front, unless the buffer is full
+    template <typename... Args>
+    constexpr option<T&> try_emplace_front(Args&&... args) {
+        if (full()) { return null; }
+        auto idx = head_ == 0 ? capacity() - 1 : head_ - 1;
+        auto ptr = std::construct_at(storage_.data() + idx,
+                                     std::forward<Args>(args)...);
+        head_ = idx;
+        ++size_;
+        return option<T&>(*ptr);
+    }
+
+    template <typename U = T>
+    constexpr option<T&> try_push_back(U&& value) {
+        return try_emplace_back(std::forward<U>(value));
+    }
+
+    template <typename U = T>
+    constexpr option<T&> try_push_front(U&& value) {
+        return try_emplace_front(std::forward<U>(value));
+    }
+
+    /// @brief Constructs an element at the back, evicting the front element
+    /// if the buffer is full
+    ///
+    /// @return The evicted element, if any
+    template <typename... Args>
+    constexpr option<T> emplace_back_overwrite(Args&&... args) {
+        if (capacity() == 0) { return null; }
+        if (!full()) {
+            try_emplace_back(std::forward<Args>(args)...);
+            return null;
+        }
+        T value(std::forward<Args>(args)...);
+        option<T> evicted(std::move(*slot(0)));
+        *slot(0) = std::move(value);
+        head_ = wrap(head_ + 1);
+        return evicted;
+    }
+
+    /// @brief Constructs an element at the front, evicting the back element
+    /// if the buffer is full
+    ///
+    /// @return The evicted element, if any
+    template <typename... Args>
+    constexpr option<T> emplace_front_overwrite(Args&&... args) {
+        if (capacity() == 0) { return null; }
+        if (!full()) {
+            try_emplace_front(std::forward<Args>(args)...);
+            return null;
+        }
+        T value(std::forward<Args>(args)...);
+        option<T> evicted(std::move(*slot(size_ - 1)));
+        *slot(size_ - 1) = std::move(value);
+        head_ = head_ == 0 ? capacity() - 1 : head_ - 1;
+        return evicted;
+    }
+
+    template <typename U = T>
+    constexpr option<T> push_back_overwrite(U&& value) {
+        return emplace_back_overwrite(std::forward<U>(value));
+    }
+
+    template <typename U = T>
+    constexpr option<T> push_front_overwrite(U&& value) {
+        return emplace_front_overwrite(std::forward<U>(value));
+    }
+
+    constexpr option<T> pop_front() {
+        if (size_ == 0) { return null; }
+        auto ptr = slot(0);
+        option<T> ret(std::move(*ptr));
+        std::destroy_at(ptr);
+        head_ = wrap(head_ + 1);
+        --size_;
+        return ret;
+    }
+
+    constexpr option<T> pop_back() {
+        if (size_ == 0) { return null; }
+        auto ptr = slot(size_ - 1);
+        option<T> ret(std::move(*ptr));
+        std::destroy_at(ptr);
+        --size_;
+        return ret;
+    }
+
+    constexpr iterator begin() noexcept { return iterator(this, 0); }
+
+    constexpr const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+    constexpr iterator end() noexcept { return iterator(this, size_); }
+
+    constexpr const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+
+    constexpr const_iterator cend() const noexcept { return end(); }
+};
+
+} // namespace jac
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef JAC_SHARDED_CACHE_HPP
+#define JAC_SHARDED_CACHE_HPP
+
+/// @file
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <jac/macros.hpp>
+#include <jac/option.hpp>
+#include <jac/result.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+/// @brief A thread-safe cache made of independently locked shards
+///
+/// @details
+/// `sharded_cache` wraps several instances of `Cache`, such as `lru_cache` or
+/// `clock_cache`, each guarded by its own mutex, and routes every key to one
+/// of them by its hash. Threads working on different keys then rarely contend
+/// on the same lock. Eviction happens per shard, so the capacity passed to
+/// the constructor applies to each shard.
+///
+/// Keys are routed with a copy of the hash function of the first shard, so
+/// a seeded or stateful hasher passed to the constructor is used for both.
+/// `Cache` must provide it through `hash_function()`.
+///
+/// Since an entry may be evicted by another thread as soon as the shard's
+/// lock is released, lookups return copies of the values. `visit` can be used
+/// to work with a value in place while the lock is held.
+template <typename Cache>
+class sharded_cache {
+  private:
+    using key_type_ = typename Cache::key_type;
+    using hasher_type_ = typename Cache::hasher;
+
+    struct shard {
+        std::mutex mutex;
+        Cache cache;
+
+        template <typename... Args>
+        explicit shard(const Args&... args) : cache(args...) {}
+    };
+
+    std::vector<std::unique_ptr<shard>> shards_;
+    JAC_NO_UNIQ_ADDR hasher_type_ hasher_;
+
+    template <typename... Args>
+    static std::vector<std::unique_ptr<shard>> make_shards(
+        size_t shard_count,
+        const Args&... args) {
+        if (shard_count == 0) {
+            throw std::invalid_argument("jac::sharded_cache needs a shard");
+        }
+        std::vector<std::unique_ptr<shard>> shards;
+        shards.reserve(shard_count);
+        for (size_t i = 0; i < shard_count; ++i) {
+            shards.push_back(std::make_unique<shard>(args...));
+        }
+        return shards;
+    }
+
+    // Uses the upper bits of the hash, since the shards' own tables index by
+    // the lower ones
+    shard& shard_for(const key_type_& key) const {
+        constexpr int half = std::numeric_limits<size_t>::digits / 2;
+        auto h = static_cast<size_t>(hash_mix(hasher_(key)) >> (64 - half));
+        return *shards_[(h * shards_.size()) >> half];
+    }
+
+  public:
+    using key_type = typename Cache::key_type;
+    using mapped_type = typename Cache::mapped_type;
+    using size_type = size_t;
+
+    /// @brief Creates `shard_count` shards, each constructed from `args`
+    ///
+    /// @throws std::invalid_argument if `shard_count` is zero
+    template <typename... Args>
+    explicit sharded_cache(size_type shard_count, const Args&... args)
+        : shards_(make_shards(shard_count, args...)),
+          hasher_(shards_[0]->cache.hash_function()) {}
+
+    size_type shard_count() const noexcept { return shards_.size(); }
+
+    /// @brief Total number of entries across all shards
+    size_type size() const {
+        size_type n = 0;
+        for (auto& s : shards_) {
+            std::lock_guard lock(s->mutex);
+            n += s->cache.size();
+        }
+        return n;
+    }
+
+    /// @brief Looks up an entry, marking it as used, and copies its value
+    option<mapped_type> get(const key_type& key) {
+        auto& s = shard_for(key);
+        std::lock_guard lock(s.mutex);
+        return s.cache.get(key).transform(
+            [](mapped_type& value) { return value; });
+    }
+
+    /// @brief Calls `f` with a reference to the value of an entry while its
+    /// shard is locked
+    ///
+    /// @return `true` if the entry was found
+    template <typename F>
+    bool visit(const key_type& key, F&& f) {
+        auto& s = shard_for(key);
+        std::lock_guard lock(s.mutex);
+        auto value = s.cache.get(key);
+        if (!value) { return false; }
+        std::invoke(std::forward<F>(f), *value);
+        return true;
+    }
+
+    bool contains(const key_type& key) const {
+        auto& s = shard_for(key);
+        std::lock_guard lock(s.mutex);
+        return s.cache.contains(key);
+    }
+
+    template <typename U>
+    void put(const key_type& key, U&& value) {
+        auto& s = shard_for(key);
+        std::lock_guard lock(s.mutex);
+        s.cache.put(key, std::forward<U>(value));
+    }
+
+    /// @brief Gets a copy of an entry, or creates it with `make` if it is
+    /// missing
+    ///
+    /// @details
+    /// The shard stays locked while `make` runs, so concurrent requests for
+    /// the same key create the value only once.
+    template <typename F>
+    auto try_get_or_insert(const key_type& key, F&& make)
+        -> result<mapped_type, typename std::invoke_result_t<F>::error_type> {
+        using ret =
+            result<mapped_type, typename std::invoke_result_t<F>::error_type>;
+        auto& s = shard_for(key);
+        std::lock_guard lock(s.mutex);
+        auto found = s.cache.try_get_or_insert(key, std::forward<F>(make));
+        if (!found.has_value()) {
+            return ret(in_place_error, std::move(found).error());
+        }
+        return ret(std::in_place, *found);
+    }
+
+    option<mapped_type> erase(const key_type& key) {
+        auto& s = shard_for(key);
+        std::lock_guard lock(s.mutex);
+        return s.cache.erase(key);
+    }
+
+    void clear() {
+        for (auto& s : shards_) {
+            std::lock_guard lock(s->mutex);
+            s->cache.clear();
+        }
+    }
+};
+
+} // namespace jac
+
+#endif
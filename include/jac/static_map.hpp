@@ -0,0 +1,230 @@
+#ifndef JAC_STATIC_MAP_HPP
+#define JAC_STATIC_MAP_HPP
+
+/// @file
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include <jac/option.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+namespace detail {
+
+struct static_map_disp {
+    uint32_t d1{0};
+    uint32_t d2{0};
+};
+
+struct static_map_hash {
+    size_t bucket;
+    uint64_t f1;
+    uint64_t f2;
+};
+
+constexpr static_map_hash static_map_split(uint64_t h,
+                                           size_t buckets,
+                                           size_t slots) noexcept {
+    return {static_cast<size_t>(h % buckets), (h >> 32) % slots,
+            hash_mix(h) % slots};
+}
+
+template <size_t N, size_t B>
+struct static_map_layout {
+    uint64_t seed{0};
+    std::array<static_map_disp, B> disps{};
+    // Index into the input of the entry stored in each slot
+    std::array<size_t, N> order{};
+};
+
+// Builds a minimal perfect hash with the hash-and-displace (CHD) algorithm.
+// Keys are split into buckets by one hash, and each bucket, largest first,
+// is assigned a displacement pair that moves all of its keys into free slots.
+template <typename K, typename V, size_t N, size_t B>
+constexpr static_map_layout<N, B> static_map_build(
+    const std::pair<K, V> (&entries)[N]) {
+    static_map_layout<N, B> layout;
+    for (uint64_t seed = 0; seed < 256; ++seed) {
+        std::array<static_map_hash, N> hashes{};
+        std::array<size_t, B> counts{};
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = static_map_split(
+                seeded_hash<K>{}(entries[i].first, seed), B, N);
+            ++counts[hashes[i].bucket];
+        }
+
+        // Group the keys by bucket
+        std::array<size_t, B + 1> starts{};
+        for (size_t b = 0; b < B; ++b) {
+            starts[b + 1] = starts[b] + counts[b];
+        }
+        std::array<size_t, N> members{};
+        std::array<size_t, B> fill{};
+        for (size_t i = 0; i < N; ++i) {
+            auto b = hashes[i].bucket;
+            members[starts[b] + fill[b]++] = i;
+        }
+
+        std::array<size_t, B> by_size{};
+        for (size_t b = 0; b < B; ++b) { by_size[b] = b; }
+        std::sort(by_size.begin(), by_size.end(),
+                  [&](size_t a, size_t b) { return counts[a] > counts[b]; });
+
+        std::array<bool, N> taken{};
+        // Slots claimed by the bucket currently being placed are marked with
+        // the attempt number, so they never have to be cleared.
+        std::array<size_t, N> claimed{};
+        size_t attempt = 0;
+        bool ok = true;
+        for (auto b : by_size) {
+            if (counts[b] == 0) { break; }
+            for (size_t i = starts[b]; i < starts[b + 1]; ++i) {
+                for (size_t j = starts[b]; j < i; ++j) {
+                    if (entries[members[i]].first ==
+                        entries[members[j]].first) {
+                        throw std::invalid_argument(
+                            "duplicate key in jac::static_map");
+                    }
+                }
+            }
+
+            bool placed = false;
+            for (uint64_t d1 = 0; d1 < N && !placed; ++d1) {
+                for (uint64_t d2 = 0; d2 < N && !placed; ++d2) {
+                    ++attempt;
+                    placed = true;
+                    for (size_t i = starts[b]; i < starts[b + 1]; ++i) {
+                        auto& h = hashes[members[i]];
+                        auto slot = (h.f1 + d1 * h.f2 + d2) % N;
+                        if (taken[slot] || claimed[slot] == attempt) {
+                            placed = false;
+                            break;
+                        }
+                        claimed[slot] = attempt;
+                    }
+                    if (placed) {
+                        layout.disps[b] = {static_cast<uint32_t>(d1),
+                                           static_cast<uint32_t>(d2)};
+                        for (size_t i = starts[b]; i < starts[b + 1]; ++i) {
+                            auto& h = hashes[members[i]];
+                            auto slot = (h.f1 + d1 * h.f2 + d2) % N;
+                            taken[slot] = true;
+                            layout.order[slot] = members[i];
+                        }
+                    }
+                }
+            }
+            if (!placed) {
+                ok = false;
+                break;
+            }
+        }
+
+        if (ok) {
+            layout.seed = seed;
+            return layout;
+        }
+        layout.disps = {};
+    }
+    throw std::logic_error(
+        "failed to build a perfect hash for jac::static_map");
+}
+
+} // namespace detail
+
+/// @brief An immutable map whose perfect hash table is built at compile time
+///
+/// @details
+/// `static_map` is constructed from a fixed list of key/value pairs, usually
+/// through `make_static_map` in a `constexpr` context, so that the whole table
+/// is computed by the compiler and requires no initialization at run time.
+/// Keys are placed with a minimal perfect hash, so each lookup hashes the key
+/// once, reads one displacement pair, and compares against exactly one
+/// stored key.
+///
+/// Keys are hashed with `jac::seeded_hash<K>`, which supports integers,
+/// enumerations and string types out of the box.
+/// ```
+/// static constexpr auto keywords =
+///     jac::make_static_map<std::string_view, token>({
+///         {"if", token::if_kw},
+///         {"else", token::else_kw},
+///         {"while", token::while_kw},
+///     });
+///
+/// auto tok = keywords.find(word); // jac::option<const token&>
+/// ```
+template <typename K, typename V, size_t N>
+class static_map {
+  private:
+    static constexpr size_t bucket_count = N < 4 ? 1 : N / 4;
+
+    uint64_t seed_;
+    std::array<detail::static_map_disp, bucket_count> disps_;
+    std::array<std::pair<K, V>, N> entries_;
+
+    template <size_t... IDX>
+    constexpr static_map(
+        const std::pair<K, V> (&entries)[N],
+        const detail::static_map_layout<N, bucket_count>& layout,
+        [[maybe_unused]] std::index_sequence<IDX...> seq)
+        : seed_(layout.seed),
+          disps_(layout.disps),
+          entries_{entries[layout.order[IDX]]...} {}
+
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = size_t;
+    using const_iterator = typename std::array<value_type, N>::const_iterator;
+    using iterator = const_iterator;
+
+    constexpr explicit static_map(const std::pair<K, V> (&entries)[N])
+        : static_map(
+              entries,
+              detail::static_map_build<K, V, N, bucket_count>(entries),
+              std::make_index_sequence<N>{}) {}
+
+    static constexpr size_type size() noexcept { return N; }
+
+    static constexpr bool empty() noexcept { return N == 0; }
+
+    constexpr option<const V&> find(const K& key) const noexcept {
+        auto h = detail::static_map_split(seeded_hash<K>{}(key, seed_),
+                                          bucket_count, N);
+        auto d = disps_[h.bucket];
+        auto& entry = entries_[(h.f1 + d.d1 * h.f2 + d.d2) % N];
+        if (entry.first == key) {
+            return option<const V&>(entry.second);
+        } else {
+            return null;
+        }
+    }
+
+    constexpr bool contains(const K& key) const noexcept {
+        return find(key).has_value();
+    }
+
+    /// @brief Iterates over the entries in hash table order
+    constexpr const_iterator begin() const noexcept { return entries_.begin(); }
+
+    constexpr const_iterator end() const noexcept { return entries_.end(); }
+};
+
+/// @brief Builds a `static_map` at compile time
+template <typename K, typename V, size_t N>
+consteval static_map<K, V, N> make_static_map(
+    const std::pair<K, V> (&entries)[N]) {
+    return static_map<K, V, N>(entries);
+}
+
+} // namespace jac
+
+#endif
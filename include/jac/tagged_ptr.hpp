@@ -0,0 +1,167 @@
+#ifndef JAC_TAGGED_PTR_HPP
+#define JAC_TAGGED_PTR_HPP
+
+/// @file
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include <jac/macros.hpp>
+#include <jac/relocate.hpp>
+
+namespace jac {
+
+/// @brief A pointer that stores a small tag in its unused bits
+///
+/// @details
+/// The tag is split between the low bits of the pointer, which are always
+/// zero because of the alignment of `T`, and `JAC_POINTER_HIGH_BITS` bits
+/// starting at bit 48, which are unused by user-space addresses on x86-64
+/// and AArch64. The low bits are used first, so a tag that fits in the
+/// alignment of `T` makes no assumption about the address space.
+///
+/// On AArch64 only bits 48 to 55 are used, so the top byte stays free for
+/// hardware pointer tagging. On x86-64 bits 48 to 63 are all used, which
+/// conflicts with Linear Address Masking and with addresses above 47 bits
+/// under 5-level paging. Define `JAC_POINTER_HIGH_BITS` to a smaller value,
+/// such as 0, when either is in use.
+///
+/// A `tagged_ptr` is the size of a pointer, which makes it useful for
+/// pointer-sized variants and for lock-free structures that pair a pointer
+/// with a counter or state.
+/// ```
+/// jac::tagged_ptr<node, 2> link(&n, color::red);
+/// link.set_tag(color::black);
+/// link->value = 7;
+/// ```
+template <typename T, unsigned Bits>
+class tagged_ptr {
+  private:
+    static constexpr unsigned align_bits = std::countr_zero(alignof(T));
+    static constexpr unsigned high_shift = 48;
+    static constexpr unsigned low_used = Bits < align_bits ? Bits : align_bits;
+    static constexpr unsigned high_used = Bits - low_used;
+
+    static_assert(sizeof(uintptr_t) == sizeof(T*),
+                  "jac::tagged_ptr needs pointers that fit in uintptr_t");
+    static_assert(high_used <= JAC_POINTER_HIGH_BITS,
+                  "too many tag bits for this jac::tagged_ptr");
+
+    static constexpr uintptr_t low_mask = (uintptr_t(1) << low_used) - 1;
+    static constexpr uintptr_t high_mask = [] {
+        if constexpr (high_used == 0) {
+            return uintptr_t(0);
+        } else {
+            return ((uintptr_t(1) << high_used) - 1) << high_shift;
+        }
+    }();
+
+    uintptr_t word_{0};
+
+    static constexpr uintptr_t encode(uintptr_t tag) noexcept {
+        if constexpr (high_used == 0) {
+            return tag;
+        } else {
+            return (tag & low_mask) | (tag >> low_used << high_shift);
+        }
+    }
+
+    static uintptr_t check_ptr(T* ptr) {
+        auto bits = reinterpret_cast<uintptr_t>(ptr);
+        if ((bits & tag_mask) != 0) {
+            throw std::invalid_argument(
+                "pointer does not fit in a jac::tagged_ptr");
+        }
+        return bits;
+    }
+
+    static uintptr_t check_tag(uintptr_t tag) {
+        if (tag > max_tag) {
+            throw std::invalid_argument(
+                "tag does not fit in a jac::tagged_ptr");
+        }
+        return encode(tag);
+    }
+
+  public:
+    using element_type = T;
+
+    /// @brief The bits of the word that hold the tag
+    static constexpr uintptr_t tag_mask = low_mask | high_mask;
+
+    static constexpr uintptr_t max_tag = (uintptr_t(1) << Bits) - 1;
+
+    /// @brief Creates a null pointer with a tag of zero
+    constexpr tagged_ptr() noexcept = default;
+
+    constexpr tagged_ptr([[maybe_unused]] std::nullptr_t null) noexcept {}
+
+    /// @brief Creates a tagged pointer
+    ///
+    /// @throws std::invalid_argument if `ptr` is misaligned or uses the bits
+    /// that hold the tag, or if `tag` is greater than `max_tag`
+    template <typename Tag = uintptr_t>
+        requires(std::is_integral_v<Tag> || std::is_enum_v<Tag>)
+    explicit tagged_ptr(T* ptr, Tag tag = Tag())
+        : word_(check_ptr(ptr) | check_tag(static_cast<uintptr_t>(tag))) {}
+
+    T* get() const noexcept {
+        return reinterpret_cast<T*>(word_ & ~tag_mask);
+    }
+
+    constexpr uintptr_t tag() const noexcept {
+        if constexpr (high_used == 0) {
+            return word_ & low_mask;
+        } else {
+            return (word_ & low_mask) |
+                   ((word_ & high_mask) >> high_shift << low_used);
+        }
+    }
+
+    /// @brief Replaces the pointer, keeping the tag
+    ///
+    /// @throws std::invalid_argument if `ptr` does not fit
+    void set(T* ptr) { word_ = check_ptr(ptr) | (word_ & tag_mask); }
+
+    /// @brief Replaces the tag, keeping the pointer
+    ///
+    /// @throws std::invalid_argument if `tag` is greater than `max_tag`
+    template <typename Tag>
+        requires(std::is_integral_v<Tag> || std::is_enum_v<Tag>)
+    void set_tag(Tag tag) {
+        word_ = (word_ & ~tag_mask) | check_tag(static_cast<uintptr_t>(tag));
+    }
+
+    /// @brief The pointer and tag as stored
+    constexpr uintptr_t raw() const noexcept { return word_; }
+
+    T& operator*() const noexcept { return *get(); }
+
+    T* operator->() const noexcept { return get(); }
+
+    /// @brief Checks if the pointer is not null, ignoring the tag
+    constexpr explicit operator bool() const noexcept {
+        return (word_ & ~tag_mask) != 0;
+    }
+
+    friend constexpr bool operator==(const tagged_ptr& lhs,
+                                     const tagged_ptr& rhs) noexcept = default;
+};
+
+template <typename T, unsigned Bits>
+struct is_trivially_relocatable<tagged_ptr<T, Bits>> : std::true_type {};
+
+} // namespace jac
+
+template <typename T, unsigned Bits>
+struct std::hash<::jac::tagged_ptr<T, Bits>> {
+    size_t operator()(const ::jac::tagged_ptr<T, Bits>& ptr) const noexcept {
+        return std::hash<uintptr_t>()(ptr.raw());
+    }
+};
+
+#endif
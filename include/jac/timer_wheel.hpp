@@ -0,0 +1,319 @@
+#ifndef JAC_TIMER_WHEEL_HPP
+#define JAC_TIMER_WHEEL_HPP
+
+/// @file
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <jac/option.hpp>
+
+namespace jac {
+
+/// @brief A hierarchical timer wheel holding values that expire at given
+/// times
+///
+/// @details
+/// Time is measured in ticks of whatever unit the user chooses, such as
+/// milliseconds. The wheel has 11 levels of 64 slots, where each slot of
+/// level `l` covers 64<sup>l</sup> ticks, so the whole 64-bit range of
+/// deadlines is covered. A timer is placed in the lowest level whose range
+/// contains its deadline, and moves to lower levels as the time approaches
+/// it, which happens at most once per level.
+///
+/// Scheduling and cancelling are O(1), and `advance` costs O(1) per expired
+/// or moved timer, skipping over empty slots with a per-level occupancy mask
+/// instead of visiting every tick. Timers live in a single array linked by
+/// 32-bit indices and are reused after they expire, so a wheel that has
+/// reached its peak size does not allocate.
+/// ```
+/// jac::timer_wheel<connection_id> timeouts;
+/// auto handle = timeouts.schedule(now + 30'000, id);
+///
+/// // When the connection is closed before its timeout
+/// timeouts.cancel(handle);
+///
+/// // In the event loop
+/// timeouts.advance(now, [&](connection_id id) { close(id); });
+/// ```
+template <typename T>
+class timer_wheel {
+  private:
+    static constexpr unsigned slot_bits = 6;
+    static constexpr size_t slot_count = size_t(1) << slot_bits;
+    static constexpr size_t level_count = 11;
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    struct node {
+        option<T> value;
+        uint64_t deadline{0};
+        uint32_t prev{npos};
+        // Also links the free list
+        uint32_t next{npos};
+        uint32_t generation{0};
+        uint32_t bucket{0};
+    };
+
+    std::vector<node> nodes_;
+    std::array<uint32_t, level_count * slot_count> heads_;
+    std::array<uint64_t, level_count> occupied_{};
+    std::vector<T> batch_;
+    uint64_t now_;
+    size_t size_{0};
+    uint32_t free_{npos};
+
+    static unsigned level_for(uint64_t now, uint64_t deadline) noexcept {
+        auto significant = (now ^ deadline) | (slot_count - 1);
+        return static_cast<unsigned>(63 - std::countl_zero(significant)) /
+               slot_bits;
+    }
+
+    void link(uint32_t idx) noexcept {
+        auto& n = nodes_[idx];
+        auto deadline = n.deadline < now_ ? now_ : n.deadline;
+        auto level = level_for(now_, deadline);
+        auto slot = (deadline >> (level * slot_bits)) & (slot_count - 1);
+        n.bucket = static_cast<uint32_t>(level * slot_count + slot);
+        n.prev = npos;
+        n.next = heads_[n.bucket];
+        if (n.next != npos) { nodes_[n.next].prev = idx; }
+        heads_[n.bucket] = idx;
+        occupied_[level] |= uint64_t(1) << slot;
+    }
+
+    void unlink(uint32_t idx) noexcept {
+        auto& n = nodes_[idx];
+        if (n.prev != npos) {
+            nodes_[n.prev].next = n.next;
+        } else {
+            heads_[n.bucket] = n.next;
+            if (n.next == npos) {
+                occupied_[n.bucket / slot_count] &=
+                    ~(uint64_t(1) << (n.bucket % slot_count));
+            }
+        }
+        if (n.next != npos) { nodes_[n.next].prev = n.prev; }
+    }
+
+    T release(uint32_t idx) {
+        auto& n = nodes_[idx];
+        T value = *std::move(n.value);
+        n.value.reset();
+        ++n.generation;
+        n.next = free_;
+        free_ = idx;
+        --size_;
+        return value;
+    }
+
+    // Finds the earliest occupied slot, returning its bucket and start time
+    option<std::pair<uint32_t, uint64_t>> next_slot() const noexcept {
+        // Every timer in a level expires after every timer in the levels
+        // below it, so the first occupied level holds the earliest slot
+        for (unsigned level = 0; level < level_count; ++level) {
+            if (occupied_[level] == 0) { continue; }
+            auto shift = level * slot_bits;
+            auto current = (now_ >> shift) & (slot_count - 1);
+            auto pending = occupied_[level] >> current;
+            if (pending == 0) { continue; }
+            auto slot = current + std::countr_zero(pending);
+            auto range_bits = shift + slot_bits;
+            auto base = range_bits >= 64 ? 0 : now_ >> range_bits << range_bits;
+            return std::pair(static_cast<uint32_t>(level * slot_count + slot),
+                             base | (uint64_t(slot) << shift));
+        }
+        return null;
+    }
+
+    bool is_live(uint32_t index, uint32_t generation) const noexcept {
+        return index < nodes_.size() &&
+               nodes_[index].generation == generation &&
+               nodes_[index].value.has_value();
+    }
+
+  public:
+    using value_type = T;
+    using size_type = size_t;
+
+    /// @brief Identifies a scheduled timer
+    ///
+    /// @details
+    /// A handle stays safe to use after its timer expires or is cancelled,
+    /// at which point it no longer refers to any timer, even if the timer's
+    /// storage is reused.
+    class handle {
+      private:
+        friend class timer_wheel;
+
+        uint32_t index_{npos};
+        uint32_t generation_{0};
+
+        constexpr handle(uint32_t index, uint32_t generation) noexcept
+            : index_(index), generation_(generation) {}
+
+      public:
+        /// @brief Creates a handle that refers to no timer
+        constexpr handle() noexcept = default;
+
+        friend constexpr bool operator==(const handle& lhs,
+                                         const handle& rhs) noexcept = default;
+    };
+
+    /// @brief Creates an empty wheel whose current time is `now`
+    explicit timer_wheel(uint64_t now = 0) noexcept : now_(now) {
+        heads_.fill(npos);
+    }
+
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief The time the wheel has been advanced to
+    uint64_t now() const noexcept { return now_; }
+
+    /// @brief Preallocates storage for `count` timers
+    void reserve(size_type count) { nodes_.reserve(count); }
+
+    /// @brief Schedules `value` to expire at `deadline`
+    ///
+    /// @details
+    /// A deadline that is not after the current time expires on the next
+    /// call to `advance`.
+    ///
+    /// @throws std::length_error if the wheel already holds 2<sup>32</sup> - 1
+    /// timers
+    template <typename U = T>
+    handle schedule(uint64_t deadline, U&& value) {
+        uint32_t idx = free_;
+        if (idx != npos) {
+            free_ = nodes_[idx].next;
+        } else {
+            if (nodes_.size() >= npos) {
+                throw std::length_error("too many jac::timer_wheel timers");
+            }
+            idx = static_cast<uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        auto& n = nodes_[idx];
+        n.value.emplace(std::forward<U>(value));
+        n.deadline = deadline;
+        link(idx);
+        ++size_;
+        return handle(idx, n.generation);
+    }
+
+    /// @brief Checks if `h` refers to a pending timer
+    bool contains(handle h) const noexcept {
+        return is_live(h.index_, h.generation_);
+    }
+
+    /// @brief Gets the value of a pending timer
+    option<T&> get(handle h) noexcept {
+        if (!contains(h)) { return null; }
+        return *nodes_[h.index_].value;
+    }
+
+    /// @brief Gets the deadline of a pending timer
+    option<uint64_t> deadline(handle h) const noexcept {
+        if (!contains(h)) { return null; }
+        return nodes_[h.index_].deadline;
+    }
+
+    /// @brief Moves a pending timer to a new deadline
+    ///
+    /// @return `true` if `h` referred to a pending timer
+    bool reschedule(handle h, uint64_t deadline) noexcept {
+        if (!contains(h)) { return false; }
+        unlink(h.index_);
+        nodes_[h.index_].deadline = deadline;
+        link(h.index_);
+        return true;
+    }
+
+    /// @brief Removes a pending timer
+    ///
+    /// @return The value of the timer, or null if `h` does not refer to a
+    /// pending timer
+    option<T> cancel(handle h) {
+        if (!contains(h)) { return null; }
+        unlink(h.index_);
+        return release(h.index_);
+    }
+
+    /// @brief Advances the current time to `now`, passing the value of every
+    /// timer that expires to `on_expire`
+    ///
+    /// @details
+    /// Timers are expired in batches of one slot, in order of their slots,
+    /// and the values of a batch are passed to `on_expire` as rvalues once the
+    /// wheel is consistent again. `on_expire` may therefore schedule and
+    /// cancel timers, but must not call `advance`. Timers it schedules at or
+    /// before `now` expire during the same call. If `now` is before the
+    /// current time, nothing happens.
+    ///
+    /// @return The number of expired timers
+    template <typename F>
+    size_type advance(uint64_t now, F&& on_expire) {
+        size_type expired = 0;
+        while (auto next = next_slot()) {
+            auto [bucket, start] = *next;
+            if (start > now) { break; }
+            now_ = start;
+
+            // Expire the timers that are due and move the rest to lower
+            // levels, where they land in later slots
+            auto idx = heads_[bucket];
+            heads_[bucket] = npos;
+            occupied_[bucket / slot_count] &=
+                ~(uint64_t(1) << (bucket % slot_count));
+            while (idx != npos) {
+                auto next_idx = nodes_[idx].next;
+                if (nodes_[idx].deadline <= now_) {
+                    batch_.push_back(release(idx));
+                } else {
+                    link(idx);
+                }
+                idx = next_idx;
+            }
+
+            expired += batch_.size();
+            auto batch = std::move(batch_);
+            for (auto& value : batch) {
+                std::invoke(on_expire, std::move(value));
+            }
+            batch.clear();
+            batch_ = std::move(batch);
+        }
+        if (now > now_) { now_ = now; }
+        return expired;
+    }
+
+    /// @brief Cancels every timer
+    void clear() noexcept {
+        for (auto& n : nodes_) {
+            if (n.value.has_value()) {
+                n.value.reset();
+                ++n.generation;
+            }
+        }
+        // Rebuild the free list so that low indices are reused first
+        free_ = npos;
+        for (auto i = nodes_.size(); i-- > 0;) {
+            nodes_[i].next = free_;
+            free_ = static_cast<uint32_t>(i);
+        }
+        heads_.fill(npos);
+        occupied_.fill(0);
+        size_ = 0;
+    }
+};
+
+} // namespace jac
+
+#endif
@@ -70,6 +70,12 @@ struct null_t {
 /// @brief An instance of nothing, or none
 static inline constexpr null_t null{};
 
+/// @brief Tag type indicating that input is sorted and free of duplicates
+struct sorted_unique_t {};
+
+/// @brief Tag indicating that input is sorted and free of duplicates
+static inline constexpr sorted_unique_t sorted_unique{};
+
 } // namespace jac
 
 #endif
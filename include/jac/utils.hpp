@@ -4,13 +4,134 @@
 /// @file
 
 #include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace jac {
 
+namespace detail {
+
+// Appends an unsigned integer in little-endian byte order, independent of the
+// host's endianness, for use in serialized formats.
+template <typename U>
+void store_le(std::vector<std::byte>& out, U value) {
+    for (size_t i = 0; i < sizeof(U); ++i) {
+        out.push_back(static_cast<std::byte>(value >> (8 * i)));
+    }
+}
+
+// Reads an unsigned integer written by `store_le` and advances `in` past it.
+// The caller checks that `in` is long enough.
+template <typename U>
+U load_le(std::span<const std::byte>& in) noexcept {
+    U value = 0;
+    for (size_t i = 0; i < sizeof(U); ++i) {
+        value |= static_cast<U>(static_cast<U>(in[i]) << (8 * i));
+    }
+    in = in.subspan(sizeof(U));
+    return value;
+}
+
+// Byte offset of the data member `Member` within its class `T`, used to get
+// from a hook embedded in an object back to the object.
+//
+// `offsetof` cannot name a member through a member pointer, and is only
+// conditionally supported for classes that are not standard layout, so the
+// offset is read off `Member` applied to storage that holds no `T`. The
+// standard leaves this undefined, and it relies on GCC, Clang and MSVC
+// lowering it to plain address arithmetic, without reading the storage, as
+// intrusive container libraries commonly do. It cannot be a constant
+// expression, but since both the storage address and `Member` are constants,
+// the optimizer folds it to a constant in each caller.
+template <typename T, typename M, M T::*Member>
+size_t member_offset() noexcept {
+    alignas(T) static unsigned char storage[sizeof(T)];
+    auto obj = reinterpret_cast<T*>(storage);
+    auto field = reinterpret_cast<unsigned char*>(&(obj->*Member));
+    return static_cast<size_t>(field - storage);
+}
+
+// Gets the object that contains `*ptr` as its `Member`
+template <typename T, typename M, M T::*Member>
+T* owner_of(M* ptr) noexcept {
+    return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(ptr) -
+                                member_offset<T, M, Member>());
+}
+
+} // namespace detail
+
 constexpr size_t hash_combine(size_t x, size_t y) noexcept {
     return x ^ (y + 0x9e3779b9 + (x << 6) + (x >> 2));
 }
 
+/// @brief Scrambles the bits of a 64-bit value
+///
+/// @details
+/// This is the finalizer of the splitmix64 generator. Every input bit affects
+/// every output bit, which makes it suitable for turning a weak hash, such as
+/// an identity `std::hash` of an integer, into one whose bits can be sliced
+/// up independently.
+constexpr uint64_t hash_mix(uint64_t x) noexcept {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111eb;
+    x ^= x >> 31;
+    return x;
+}
+
+/// @brief Hashes a sequence of bytes with a seed, usable in constant
+/// expressions
+constexpr uint64_t hash_bytes(std::string_view bytes,
+                              uint64_t seed = 0) noexcept {
+    auto load = [&](size_t pos, size_t len) {
+        uint64_t word = 0;
+        for (size_t i = 0; i < len; ++i) {
+            word |= static_cast<uint64_t>(static_cast<unsigned char>(
+                        bytes[pos + i]))
+                    << (8 * i);
+        }
+        return word;
+    };
+
+    uint64_t h = hash_mix(seed ^ (bytes.size() * 0x9e3779b97f4a7c15));
+    size_t pos = 0;
+    for (; pos + 8 <= bytes.size(); pos += 8) {
+        h = hash_mix(h ^ load(pos, 8)) * 0x9e3779b97f4a7c15;
+    }
+    return hash_mix(h ^ load(pos, bytes.size() - pos));
+}
+
+/// @brief Seeded hash function object usable in constant expressions
+///
+/// @details
+/// Unlike `std::hash`, `seeded_hash` takes a seed so that a family of
+/// independent hash functions can be derived from it, and it can be evaluated
+/// at compile time. It is defined for integral types, enumerations, and types
+/// convertible to `std::string_view`, and can be specialized for other types.
+template <typename T>
+struct seeded_hash;
+
+template <typename T>
+    requires(std::is_integral_v<T> || std::is_enum_v<T>)
+struct seeded_hash<T> {
+    constexpr uint64_t operator()(T value, uint64_t seed = 0) const noexcept {
+        return hash_mix(static_cast<uint64_t>(value) ^ hash_mix(seed));
+    }
+};
+
+template <typename T>
+    requires(std::is_convertible_v<const T&, std::string_view>)
+struct seeded_hash<T> {
+    constexpr uint64_t operator()(const T& value,
+                                  uint64_t seed = 0) const noexcept {
+        return hash_bytes(std::string_view(value), seed);
+    }
+};
+
 } // namespace jac
 
 #endif
@@ -0,0 +1,768 @@
+#ifndef JAC_VARIANT_HPP
+#define JAC_VARIANT_HPP
+
+/// @file
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <jac/holder.hpp>
+#include <jac/macros.hpp>
+#include <jac/relocate.hpp>
+#include <jac/types.hpp>
+#include <jac/utils.hpp>
+
+namespace jac {
+
+/// @brief Index of a valueless `variant`
+static inline constexpr size_t variant_npos = SIZE_MAX;
+
+class bad_variant_access : public std::exception {
+  public:
+    bad_variant_access() = default;
+    bad_variant_access(const bad_variant_access&) = default;
+    bad_variant_access(bad_variant_access&&) = default;
+    ~bad_variant_access() override = default;
+    bad_variant_access& operator=(const bad_variant_access&) = default;
+    bad_variant_access& operator=(bad_variant_access&&) = default;
+
+    const char* what() const noexcept override {
+        return "bad access of inactive jac::variant alternative";
+    }
+};
+
+namespace detail {
+
+template <size_t I, typename T, typename... Ts>
+struct variant_nth : variant_nth<I - 1, Ts...> {};
+
+template <typename T, typename... Ts>
+struct variant_nth<0, T, Ts...> {
+    using type = T;
+};
+
+template <size_t I, typename... Ts>
+using variant_alt_t = holder_impl<typename variant_nth<I, Ts...>::type>;
+
+template <typename T, typename... Ts>
+constexpr size_t variant_index_of() noexcept {
+    constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+    size_t index = variant_npos;
+    for (size_t i = 0; i < sizeof...(Ts); ++i) {
+        if (matches[i]) {
+            if (index != variant_npos) { return variant_npos; }
+            index = i;
+        }
+    }
+    return index;
+}
+
+// The smallest unsigned type that can hold every index plus the valueless
+// marker
+template <size_t N>
+using variant_index_t = std::conditional_t<
+    (N < UINT8_MAX),
+    uint8_t,
+    std::conditional_t<(N < UINT16_MAX), uint16_t, uint32_t>>;
+
+template <typename... Ts>
+union variant_union;
+
+template <>
+union variant_union<> {};
+
+template <typename T, typename... Ts>
+union variant_union<T, Ts...> {
+    holder_impl<T> head;
+    variant_union<Ts...> tail;
+
+    constexpr variant_union() noexcept {}
+
+    template <typename... Args>
+    constexpr explicit variant_union(
+        [[maybe_unused]] std::in_place_index_t<0> index,
+        Args&&... args)
+        : head(std::in_place, std::forward<Args>(args)...) {}
+
+    template <size_t I, typename... Args>
+        requires(I > 0)
+    constexpr explicit variant_union(
+        [[maybe_unused]] std::in_place_index_t<I> index,
+        Args&&... args)
+        : tail(std::in_place_index<I - 1>, std::forward<Args>(args)...) {}
+
+    constexpr variant_union(const variant_union&) = default;
+
+    constexpr variant_union(variant_union&&) = default;
+
+    constexpr ~variant_union()
+        requires(std::is_trivially_destructible_v<holder_impl<T>> &&
+                 (std::is_trivially_destructible_v<holder_impl<Ts>> && ...))
+    = default;
+
+    constexpr ~variant_union() {}
+
+    constexpr variant_union& operator=(const variant_union&) = default;
+
+    constexpr variant_union& operator=(variant_union&&) = default;
+};
+
+template <size_t I, typename U>
+constexpr auto& variant_get(U& u) noexcept {
+    if constexpr (I == 0) {
+        return u.head;
+    } else {
+        return variant_get<I - 1>(u.tail);
+    }
+}
+
+#define JAC_VARIANT_CASE(n)                                                    \
+    case n:                                                                    \
+        if constexpr (Base + n < N) {                                          \
+            return std::forward<F>(f)(                                         \
+                std::integral_constant<size_t, Base + n>{});                   \
+        }                                                                      \
+        JAC_UNREACHABLE();
+
+// Calls `f` with `std::integral_constant<size_t, index>`. Indices are
+// dispatched through switch statements of 32 cases, which compilers turn
+// into jump tables, rather than through an array of function pointers that
+// cannot be inlined.
+template <size_t N, size_t Base = 0, typename F>
+constexpr decltype(auto) variant_switch(size_t index, F&& f) {
+    switch (index - Base) {
+        JAC_VARIANT_CASE(0)
+        JAC_VARIANT_CASE(1)
+        JAC_VARIANT_CASE(2)
+        JAC_VARIANT_CASE(3)
+        JAC_VARIANT_CASE(4)
+        JAC_VARIANT_CASE(5)
+        JAC_VARIANT_CASE(6)
+        JAC_VARIANT_CASE(7)
+        JAC_VARIANT_CASE(8)
+        JAC_VARIANT_CASE(9)
+        JAC_VARIANT_CASE(10)
+        JAC_VARIANT_CASE(11)
+        JAC_VARIANT_CASE(12)
+        JAC_VARIANT_CASE(13)
+        JAC_VARIANT_CASE(14)
+        JAC_VARIANT_CASE(15)
+        JAC_VARIANT_CASE(16)
+        JAC_VARIANT_CASE(17)
+        JAC_VARIANT_CASE(18)
+        JAC_VARIANT_CASE(19)
+        JAC_VARIANT_CASE(20)
+        JAC_VARIANT_CASE(21)
+        JAC_VARIANT_CASE(22)
+        JAC_VARIANT_CASE(23)
+        JAC_VARIANT_CASE(24)
+        JAC_VARIANT_CASE(25)
+        JAC_VARIANT_CASE(26)
+        JAC_VARIANT_CASE(27)
+        JAC_VARIANT_CASE(28)
+        JAC_VARIANT_CASE(29)
+        JAC_VARIANT_CASE(30)
+        JAC_VARIANT_CASE(31)
+    default:
+        break;
+    }
+    if constexpr (Base + 32 < N) {
+        return variant_switch<N, Base + 32>(index, std::forward<F>(f));
+    }
+    JAC_UNREACHABLE();
+}
+
+#undef JAC_VARIANT_CASE
+
+// Selects the alternative a converting constructor initializes, using
+// overload resolution like `std::variant`
+struct variant_no_overload {
+    variant_no_overload() = delete;
+};
+
+template <typename T>
+using variant_array = T[1];
+
+// An overload for a value alternative only takes part if `T x[] = {u}` is
+// well-formed, which rules out narrowing conversions, including conversions
+// to `bool` from anything but `bool`, as in P0608
+template <size_t I, typename T, typename U>
+struct variant_overload {
+    void operator()(variant_no_overload none) const;
+};
+
+template <size_t I, typename T, typename U>
+    requires(std::is_object_v<T> && !std::is_array_v<T> &&
+             requires { variant_array<T>{std::declval<U>()}; })
+struct variant_overload<I, T, U> {
+    std::integral_constant<size_t, I> operator()(T value) const;
+};
+
+template <size_t I, typename T, typename U>
+struct variant_overload<I, T&, U> {
+    std::integral_constant<size_t, I> operator()(T& value) const;
+};
+
+template <typename Seq, typename U, typename... Ts>
+struct variant_overloads;
+
+template <size_t... Is, typename U, typename... Ts>
+struct variant_overloads<std::index_sequence<Is...>, U, Ts...>
+    : variant_overload<Is, Ts, U>... {
+    using variant_overload<Is, Ts, U>::operator()...;
+};
+
+template <typename U, typename... Ts>
+using variant_selected_t = decltype(variant_overloads<
+                                    std::index_sequence_for<Ts...>,
+                                    U,
+                                    Ts...>{}(std::declval<U>()));
+
+struct variant_access {
+    template <size_t I, typename V>
+    static constexpr auto& alt(V& v) noexcept {
+        return variant_get<I>(v.data_);
+    }
+
+    // Gets the value of an alternative with the value category of `v`
+    template <size_t I, typename V>
+    static constexpr decltype(auto) forward_get(V&& v) {
+        if constexpr (std::is_lvalue_reference_v<V>) {
+            return alt<I>(v).get();
+        } else {
+            return std::move(alt<I>(v)).get();
+        }
+    }
+};
+
+} // namespace detail
+
+/// @brief Type safe union of any number of types
+///
+/// @details
+/// `variant` is modeled after `std::variant`, but like `holder`, its
+/// alternatives may be references, `void` or arrays. A `void` alternative
+/// holds a `void_t`, and a reference alternative rebinds on assignment.
+///
+/// The index is stored in the smallest unsigned type that fits, usually a
+/// single byte. `visit` dispatches through switch statements, which compile
+/// to a jump table that the compiler can inline into, also when visiting
+/// several variants at once.
+///
+/// Changing the alternative first constructs the new value in a temporary
+/// when its constructor may throw, so the variant only becomes valueless if
+/// an alternative's move constructor throws. For nothrow movable
+/// alternatives, `valueless_by_exception()` is always false.
+template <typename... Ts>
+class variant {
+  private:
+    static_assert(sizeof...(Ts) > 0, "a jac::variant needs an alternative");
+
+    friend struct detail::variant_access;
+
+    static constexpr size_t count = sizeof...(Ts);
+
+    using index_type = detail::variant_index_t<count>;
+
+    static constexpr index_type valueless_index = index_type(-1);
+
+    template <size_t I>
+    using alt_t = detail::variant_alt_t<I, Ts...>;
+
+    static constexpr bool trivially_destructible =
+        (std::is_trivially_destructible_v<detail::holder_impl<Ts>> && ...);
+
+    static constexpr bool copy_constructible =
+        (std::is_copy_constructible_v<detail::holder_impl<Ts>> && ...);
+
+    static constexpr bool trivially_copy_constructible =
+        (std::is_trivially_copy_constructible_v<detail::holder_impl<Ts>> &&
+         ...);
+
+    static constexpr bool move_constructible =
+        (std::is_move_constructible_v<detail::holder_impl<Ts>> && ...);
+
+    static constexpr bool trivially_move_constructible =
+        (std::is_trivially_move_constructible_v<detail::holder_impl<Ts>> &&
+         ...);
+
+    static constexpr bool nothrow_move_constructible =
+        (std::is_nothrow_move_constructible_v<detail::holder_impl<Ts>> && ...);
+
+    static constexpr bool copy_assignable =
+        copy_constructible &&
+        (std::is_copy_assignable_v<detail::holder_impl<Ts>> && ...);
+
+    static constexpr bool trivially_copy_assignable =
+        trivially_copy_constructible && trivially_destructible &&
+        (std::is_trivially_copy_assignable_v<detail::holder_impl<Ts>> && ...);
+
+    static constexpr bool move_assignable =
+        move_constructible &&
+        (std::is_move_assignable_v<detail::holder_impl<Ts>> && ...);
+
+    static constexpr bool trivially_move_assignable =
+        trivially_move_constructible && trivially_destructible &&
+        (std::is_trivially_move_assignable_v<detail::holder_impl<Ts>> && ...);
+
+    detail::variant_union<Ts...> data_;
+    index_type index_{valueless_index};
+
+    template <size_t I, typename... Args>
+    constexpr alt_t<I>& construct(Args&&... args) {
+        auto& alt = *std::construct_at(&detail::variant_get<I>(data_),
+                                       std::forward<Args>(args)...);
+        index_ = static_cast<index_type>(I);
+        return alt;
+    }
+
+    constexpr void destroy() noexcept {
+        if constexpr (!trivially_destructible) {
+            if (index_ != valueless_index) {
+                detail::variant_switch<count>(index_, [this](auto i) {
+                    std::destroy_at(&detail::variant_get<i>(data_));
+                });
+            }
+        }
+        index_ = valueless_index;
+    }
+
+    // Constructs the alternative held by `other`, which must not be
+    // valueless, with the value category of `other`
+    template <typename V>
+    constexpr void construct_from(V&& other) {
+        detail::variant_switch<count>(other.index_, [&](auto i) {
+            construct<i>(std::forward<V>(other).template alt<i>());
+        });
+    }
+
+    template <size_t I>
+    constexpr alt_t<I>& alt() & noexcept {
+        return detail::variant_get<I>(data_);
+    }
+
+    template <size_t I>
+    constexpr const alt_t<I>& alt() const& noexcept {
+        return detail::variant_get<I>(data_);
+    }
+
+    template <size_t I>
+    constexpr alt_t<I>&& alt() && noexcept {
+        return std::move(detail::variant_get<I>(data_));
+    }
+
+    template <size_t I>
+    constexpr const alt_t<I>&& alt() const&& noexcept {
+        return std::move(detail::variant_get<I>(data_));
+    }
+
+    template <typename V>
+    constexpr void assign_from(V&& other) {
+        if (other.valueless_by_exception()) {
+            destroy();
+        } else if (index_ == other.index_) {
+            detail::variant_switch<count>(index_, [&](auto i) {
+                alt<i>() = std::forward<V>(other).template alt<i>();
+            });
+        } else {
+            detail::variant_switch<count>(other.index_, [&](auto i) {
+                using A = alt_t<i>;
+                using Arg = decltype(std::forward<V>(other).template alt<i>());
+                if constexpr (std::is_nothrow_constructible_v<A, Arg> ||
+                              !std::is_nothrow_move_constructible_v<A>) {
+                    destroy();
+                    construct<i>(std::forward<V>(other).template alt<i>());
+                } else {
+                    A tmp(std::forward<V>(other).template alt<i>());
+                    destroy();
+                    construct<i>(std::move(tmp));
+                }
+            });
+        }
+    }
+
+    // Replaces the current value with alternative `I`. When constructing it
+    // may throw, the new value is built in a temporary first, so the variant
+    // keeps its old value unless moving the temporary throws.
+    template <size_t I, typename... Args>
+    constexpr typename alt_t<I>::reference replace(Args&&... args) {
+        using A = alt_t<I>;
+        if constexpr (std::is_nothrow_constructible_v<A, std::in_place_t,
+                                                      Args...> ||
+                      !std::is_nothrow_move_constructible_v<A>) {
+            destroy();
+            return construct<I>(std::in_place, std::forward<Args>(args)...)
+                .get();
+        } else {
+            A tmp(std::in_place, std::forward<Args>(args)...);
+            destroy();
+            return construct<I>(std::move(tmp)).get();
+        }
+    }
+
+  public:
+    /// @brief Constructs the first alternative with no arguments
+    constexpr variant() noexcept(
+        std::is_nothrow_constructible_v<alt_t<0>, std::in_place_t>)
+        requires(std::is_constructible_v<alt_t<0>, std::in_place_t>)
+        : data_(std::in_place_index<0>), index_(0) {}
+
+    constexpr variant(const variant&)
+        requires(trivially_copy_constructible)
+    = default;
+
+    constexpr variant(const variant& other)
+        requires(copy_constructible && !trivially_copy_constructible)
+    {
+        if (!other.valueless_by_exception()) { construct_from(other); }
+    }
+
+    constexpr variant(variant&&)
+        requires(trivially_move_constructible)
+    = default;
+
+    constexpr variant(variant&& other) noexcept(nothrow_move_constructible)
+        requires(move_constructible && !trivially_move_constructible)
+    {
+        if (!other.valueless_by_exception()) {
+            construct_from(std::move(other));
+        }
+    }
+
+    template <size_t I, typename... Args>
+        requires(I < count &&
+                 std::is_constructible_v<alt_t<I>, std::in_place_t, Args...>)
+    constexpr explicit variant(std::in_place_index_t<I> in_place,
+                               Args&&... args)
+        : data_(in_place, std::forward<Args>(args)...),
+          index_(static_cast<index_type>(I)) {}
+
+    template <size_t I, typename U, typename... Args>
+        requires(I < count &&
+                 std::is_constructible_v<alt_t<I>,
+                                         std::in_place_t,
+                                         std::initializer_list<U>,
+                                         Args...>)
+    constexpr explicit variant(std::in_place_index_t<I> in_place,
+                               std::initializer_list<U> ilist,
+                               Args&&... args)
+        : data_(in_place, ilist, std::forward<Args>(args)...),
+          index_(static_cast<index_type>(I)) {}
+
+    template <typename T, typename... Args>
+        requires(detail::variant_index_of<T, Ts...>() != variant_npos)
+    constexpr explicit variant([[maybe_unused]] std::in_place_type_t<T> type,
+                               Args&&... args)
+        : variant(std::in_place_index<detail::variant_index_of<T, Ts...>()>,
+                  std::forward<Args>(args)...) {}
+
+    /// @brief Constructs the alternative that best matches `value`, chosen
+    /// by overload resolution
+    template <typename U,
+              typename Selected = detail::variant_selected_t<U, Ts...>>
+        requires(!std::is_same_v<std::remove_cvref_t<U>, variant>)
+    constexpr variant(U&& value) noexcept(
+        std::is_nothrow_constructible_v<alt_t<Selected::value>,
+                                        std::in_place_t,
+                                        U>)
+        : variant(std::in_place_index<Selected::value>,
+                  std::forward<U>(value)) {}
+
+    constexpr ~variant()
+        requires(trivially_destructible)
+    = default;
+
+    constexpr ~variant() { destroy(); }
+
+    constexpr variant& operator=(const variant&)
+        requires(trivially_copy_assignable)
+    = default;
+
+    constexpr variant& operator=(const variant& other)
+        requires(copy_assignable && !trivially_copy_assignable)
+    {
+        if (this != &other) { assign_from(other); }
+        return *this;
+    }
+
+    constexpr variant& operator=(variant&&)
+        requires(trivially_move_assignable)
+    = default;
+
+    constexpr variant& operator=(variant&& other) noexcept(
+        nothrow_move_constructible &&
+        (std::is_nothrow_move_assignable_v<detail::holder_impl<Ts>> && ...))
+        requires(move_assignable && !trivially_move_assignable)
+    {
+        if (this != &other) { assign_from(std::move(other)); }
+        return *this;
+    }
+
+    template <typename U,
+              typename Selected = detail::variant_selected_t<U, Ts...>>
+        requires(!std::is_same_v<std::remove_cvref_t<U>, variant>)
+    constexpr variant& operator=(U&& value) {
+        constexpr auto I = Selected::value;
+        using alternative = std::tuple_element_t<I, std::tuple<Ts...>>;
+        // A reference alternative is rebound rather than assigned through
+        if constexpr (!std::is_reference_v<alternative>) {
+            if (index_ == I) {
+                alt<I>().get() = std::forward<U>(value);
+                return *this;
+            }
+        }
+        emplace<I>(std::forward<U>(value));
+        return *this;
+    }
+
+    /// @brief Index of the current alternative, or `variant_npos` if the
+    /// variant is valueless
+    constexpr size_t index() const noexcept {
+        return index_ == valueless_index ? variant_npos : index_;
+    }
+
+    constexpr bool valueless_by_exception() const noexcept {
+        return index_ == valueless_index;
+    }
+
+    /// @brief Replaces the current value with alternative `I` constructed
+    /// from `args`
+    template <size_t I, typename... Args>
+        requires(I < count &&
+                 std::is_constructible_v<alt_t<I>, std::in_place_t, Args...>)
+    constexpr typename alt_t<I>::reference emplace(Args&&... args) {
+        return replace<I>(std::forward<Args>(args)...);
+    }
+
+    template <size_t I, typename U, typename... Args>
+        requires(I < count && std::is_constructible_v<alt_t<I>,
+                                                      std::in_place_t,
+                                                      std::initializer_list<U>,
+                                                      Args...>)
+    constexpr typename alt_t<I>::reference emplace(
+        std::initializer_list<U> ilist,
+        Args&&... args) {
+        return replace<I>(ilist, std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename... Args>
+        requires(detail::variant_index_of<T, Ts...>() != variant_npos)
+    constexpr auto& emplace(Args&&... args) {
+        return emplace<detail::variant_index_of<T, Ts...>()>(
+            std::forward<Args>(args)...);
+    }
+
+    constexpr void swap(variant& other) noexcept(
+        nothrow_move_constructible &&
+        (std::is_nothrow_swappable_v<detail::holder_impl<Ts>> && ...)) {
+        if (index_ == other.index_) {
+            if (!valueless_by_exception()) {
+                detail::variant_switch<count>(index_, [&](auto i) {
+                    alt<i>().swap(other.template alt<i>());
+                });
+            }
+        } else {
+            variant tmp(std::move(other));
+            other.destroy();
+            if (!valueless_by_exception()) {
+                other.construct_from(std::move(*this));
+            }
+            destroy();
+            if (!tmp.valueless_by_exception()) {
+                construct_from(std::move(tmp));
+            }
+        }
+    }
+
+    friend constexpr void swap(variant& lhs, variant& rhs) noexcept(
+        noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
+};
+
+/// @brief Checks if `v` holds the alternative `T`
+template <typename T, typename... Ts>
+constexpr bool holds_alternative(const variant<Ts...>& v) noexcept {
+    constexpr auto index = detail::variant_index_of<T, Ts...>();
+    static_assert(index != variant_npos,
+                  "T must occur exactly once in the alternatives");
+    return v.index() == index;
+}
+
+/// @brief Gets a pointer to alternative `I`, or null if `v` holds another
+/// alternative
+template <size_t I, typename... Ts>
+constexpr auto get_if(variant<Ts...>* v) noexcept {
+    using ptr_t = typename detail::variant_alt_t<I, Ts...>::pointer;
+    if (v == nullptr || v->index() != I) { return ptr_t(nullptr); }
+    return detail::variant_access::alt<I>(*v).ptr();
+}
+
+template <size_t I, typename... Ts>
+constexpr auto get_if(const variant<Ts...>* v) noexcept {
+    using ptr_t = typename detail::variant_alt_t<I, Ts...>::const_pointer;
+    if (v == nullptr || v->index() != I) { return ptr_t(nullptr); }
+    return detail::variant_access::alt<I>(*v).ptr();
+}
+
+template <typename T, typename... Ts>
+constexpr auto get_if(variant<Ts...>* v) noexcept {
+    return get_if<detail::variant_index_of<T, Ts...>()>(v);
+}
+
+template <typename T, typename... Ts>
+constexpr auto get_if(const variant<Ts...>* v) noexcept {
+    return get_if<detail::variant_index_of<T, Ts...>()>(v);
+}
+
+/// @brief Gets alternative `I`
+///
+/// @throws jac::bad_variant_access if `v` holds another alternative
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(variant<Ts...>& v) {
+    if (v.index() != I) { throw bad_variant_access(); }
+    return detail::variant_access::forward_get<I>(v);
+}
+
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(const variant<Ts...>& v) {
+    if (v.index() != I) { throw bad_variant_access(); }
+    return detail::variant_access::forward_get<I>(v);
+}
+
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(variant<Ts...>&& v) {
+    if (v.index() != I) { throw bad_variant_access(); }
+    return detail::variant_access::forward_get<I>(std::move(v));
+}
+
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(const variant<Ts...>&& v) {
+    if (v.index() != I) { throw bad_variant_access(); }
+    return detail::variant_access::forward_get<I>(std::move(v));
+}
+
+/// @brief Gets alternative `T`
+///
+/// @throws jac::bad_variant_access if `v` holds another alternative
+template <typename T, typename... Ts>
+constexpr decltype(auto) get(variant<Ts...>& v) {
+    return get<detail::variant_index_of<T, Ts...>()>(v);
+}
+
+template <typename T, typename... Ts>
+constexpr decltype(auto) get(const variant<Ts...>& v) {
+    return get<detail::variant_index_of<T, Ts...>()>(v);
+}
+
+template <typename T, typename... Ts>
+constexpr decltype(auto) get(variant<Ts...>&& v) {
+    return get<detail::variant_index_of<T, Ts...>()>(std::move(v));
+}
+
+template <typename T, typename... Ts>
+constexpr decltype(auto) get(const variant<Ts...>&& v) {
+    return get<detail::variant_index_of<T, Ts...>()>(std::move(v));
+}
+
+/// @brief Number of alternatives of a `variant`
+template <typename V>
+struct variant_size;
+
+template <typename... Ts>
+struct variant_size<variant<Ts...>>
+    : std::integral_constant<size_t, sizeof...(Ts)> {};
+
+template <typename V>
+struct variant_size<const V> : variant_size<V> {};
+
+template <typename V>
+static inline constexpr size_t variant_size_v = variant_size<V>::value;
+
+namespace detail {
+
+template <typename F, typename V, typename... Rest>
+constexpr decltype(auto) variant_visit(F&& f, V&& v, Rest&&... rest) {
+    if (v.valueless_by_exception()) { throw bad_variant_access(); }
+    constexpr auto count = variant_size_v<std::remove_reference_t<V>>;
+    return variant_switch<count>(v.index(), [&](auto i) -> decltype(auto) {
+        if constexpr (sizeof...(Rest) == 0) {
+            return std::invoke(
+                std::forward<F>(f),
+                variant_access::forward_get<i>(std::forward<V>(v)));
+        } else {
+            return variant_visit(
+                [&](auto&&... others) -> decltype(auto) {
+                    return std::invoke(
+                        std::forward<F>(f),
+                        variant_access::forward_get<i>(std::forward<V>(v)),
+                        std::forward<decltype(others)>(others)...);
+                },
+                std::forward<Rest>(rest)...);
+        }
+    });
+}
+
+} // namespace detail
+
+/// @brief Calls `f` with the current values of every variant in `vs`
+///
+/// @details
+/// The values are passed with the value category of their variants, and a
+/// `void` alternative is passed as `void_t`. Each variant is dispatched with
+/// its own switch statement, so visiting two variants of 30 alternatives
+/// generates 31 small jump tables rather than one table of 900 entries.
+///
+/// @throws jac::bad_variant_access if any of the variants is valueless
+template <typename F, typename... Vs>
+constexpr decltype(auto) visit(F&& f, Vs&&... vs) {
+    if constexpr (sizeof...(Vs) == 0) {
+        return std::invoke(std::forward<F>(f));
+    } else {
+        return detail::variant_visit(std::forward<F>(f),
+                                     std::forward<Vs>(vs)...);
+    }
+}
+
+template <typename... Ts>
+constexpr bool operator==(const variant<Ts...>& lhs,
+                          const variant<Ts...>& rhs) {
+    if (lhs.index() != rhs.index()) { return false; }
+    if (lhs.valueless_by_exception()) { return true; }
+    return detail::variant_switch<sizeof...(Ts)>(lhs.index(), [&](auto i) {
+        return static_cast<bool>(get<i>(lhs) == get<i>(rhs));
+    });
+}
+
+template <typename... Ts>
+struct is_trivially_relocatable<variant<Ts...>>
+    : std::bool_constant<(
+          is_trivially_relocatable_v<typename holder<Ts>::value_type> &&
+          ...)> {};
+
+} // namespace jac
+
+template <typename... Ts>
+struct std::hash<::jac::variant<Ts...>> {
+    size_t operator()(const ::jac::variant<Ts...>& v) const {
+        if (v.valueless_by_exception()) { return 0; }
+        return ::jac::detail::variant_switch<sizeof...(Ts)>(
+            v.index(), [&](auto i) -> size_t {
+                using value_t = std::remove_cvref_t<decltype(::jac::get<i>(v))>;
+                size_t h = 0;
+                if constexpr (!std::is_same_v<value_t, ::jac::void_t>) {
+                    h = std::hash<value_t>{}(::jac::get<i>(v));
+                }
+                return ::jac::hash_combine(i, h);
+            });
+    }
+};
+
+#endif
@@ -0,0 +1,373 @@
+#ifndef JAC_VIEWS_HPP
+#define JAC_VIEWS_HPP
+
+/// @file
+
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include <jac/macros.hpp>
+#include <jac/option.hpp>
+#include <jac/pipeline.hpp>
+#include <jac/result.hpp>
+
+namespace jac {
+
+namespace detail {
+
+// Makes `range | adaptor` call `adaptor(range)`
+template <typename Derived>
+struct view_closure {
+    template <std::ranges::viewable_range R>
+        requires std::invocable<const Derived&, R>
+    friend constexpr auto operator|(R&& r, const Derived& adaptor) {
+        return adaptor(std::forward<R>(r));
+    }
+};
+
+// An option that is left empty when its owner is copied or moved, for caches
+// of iterators that would otherwise refer into another object
+template <typename T>
+class non_propagating_cache : public option<T> {
+  public:
+    non_propagating_cache() = default;
+
+    constexpr non_propagating_cache(
+        [[maybe_unused]] const non_propagating_cache& other) noexcept
+        : option<T>() {}
+
+    constexpr non_propagating_cache(non_propagating_cache&& other) noexcept
+        : option<T>() {
+        other.reset();
+    }
+
+    constexpr non_propagating_cache& operator=(
+        const non_propagating_cache& other) noexcept {
+        if (this != &other) { this->reset(); }
+        return *this;
+    }
+
+    constexpr non_propagating_cache& operator=(
+        non_propagating_cache&& other) noexcept {
+        this->reset();
+        other.reset();
+        return *this;
+    }
+};
+
+enum class select_kind { values, errors };
+
+template <select_kind K, typename E>
+constexpr decltype(auto) select_get(E&& e) {
+    if constexpr (K == select_kind::values) {
+        return *std::forward<E>(e);
+    } else {
+        return std::forward<E>(e).error();
+    }
+}
+
+template <typename V, select_kind K>
+concept selectable_range =
+    std::ranges::input_range<V> &&
+    (K == select_kind::values
+         ? option_or_result<std::ranges::range_reference_t<V>>
+         : is_result_v<std::remove_cvref_t<std::ranges::range_reference_t<V>>>);
+
+// A view of the values or errors of a range of options or results, skipping
+// the other elements
+template <std::ranges::view V, select_kind K>
+    requires selectable_range<V, K>
+class select_view : public std::ranges::view_interface<select_view<V, K>> {
+  private:
+    using base_iterator = std::ranges::iterator_t<V>;
+    using base_sentinel = std::ranges::sentinel_t<V>;
+    using base_reference = std::ranges::range_reference_t<V>;
+    using element = decltype(select_get<K>(std::declval<base_reference>()));
+    // The elements of a range of prvalues are moved out, since references to
+    // them would dangle
+    using element_reference =
+        std::conditional_t<std::is_reference_v<base_reference>,
+                           element,
+                           std::remove_cvref_t<element>>;
+
+    V base_ = V();
+    // Cached so that repeated calls to begin take O(1), as for
+    // std::views::filter
+    non_propagating_cache<base_iterator> begin_;
+
+    static constexpr bool keep(base_reference e) {
+        return e.has_value() == (K == select_kind::values);
+    }
+
+    constexpr base_iterator skip(base_iterator it) {
+        auto last = std::ranges::end(base_);
+        while (it != last && !keep(*it)) { ++it; }
+        return it;
+    }
+
+    class sentinel;
+
+    class iterator {
+      private:
+        friend class select_view;
+
+        select_view* parent_{nullptr};
+        base_iterator current_ = base_iterator();
+
+        constexpr iterator(select_view& parent, base_iterator current)
+            : parent_(&parent), current_(std::move(current)) {}
+
+      public:
+        using iterator_concept = std::conditional_t<
+            std::ranges::bidirectional_range<V>,
+            std::bidirectional_iterator_tag,
+            std::conditional_t<std::ranges::forward_range<V>,
+                               std::forward_iterator_tag,
+                               std::input_iterator_tag>>;
+        using value_type = std::remove_cvref_t<element_reference>;
+        using difference_type = std::ranges::range_difference_t<V>;
+
+        iterator()
+            requires std::default_initializable<base_iterator>
+        = default;
+
+        constexpr const base_iterator& base() const& noexcept {
+            return current_;
+        }
+
+        constexpr base_iterator base() && { return std::move(current_); }
+
+        constexpr element_reference operator*() const {
+            return select_get<K>(*current_);
+        }
+
+        constexpr iterator& operator++() {
+            current_ = parent_->skip(++current_);
+            return *this;
+        }
+
+        constexpr void operator++(int) { ++*this; }
+
+        constexpr iterator operator++(int)
+            requires std::ranges::forward_range<V>
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        constexpr iterator& operator--()
+            requires std::ranges::bidirectional_range<V>
+        {
+            do {
+                --current_;
+            } while (!keep(*current_));
+            return *this;
+        }
+
+        constexpr iterator operator--(int)
+            requires std::ranges::bidirectional_range<V>
+        {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        friend constexpr bool operator==(const iterator& lhs,
+                                         const iterator& rhs)
+            requires std::equality_comparable<base_iterator>
+        {
+            return lhs.current_ == rhs.current_;
+        }
+    };
+
+    class sentinel {
+      private:
+        base_sentinel end_ = base_sentinel();
+
+      public:
+        sentinel() = default;
+
+        constexpr explicit sentinel(select_view& parent)
+            : end_(std::ranges::end(parent.base_)) {}
+
+        friend constexpr bool operator==(const iterator& it,
+                                         const sentinel& s) {
+            return it.base() == s.end_;
+        }
+    };
+
+  public:
+    select_view()
+        requires std::default_initializable<V>
+    = default;
+
+    constexpr explicit select_view(V base) : base_(std::move(base)) {}
+
+    constexpr V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+
+    constexpr V base() && { return std::move(base_); }
+
+    constexpr iterator begin() {
+        if constexpr (std::ranges::forward_range<V>) {
+            if (!begin_.has_value()) {
+                begin_.emplace(skip(std::ranges::begin(base_)));
+            }
+            return iterator(*this, *begin_);
+        } else {
+            return iterator(*this, skip(std::ranges::begin(base_)));
+        }
+    }
+
+    constexpr auto end() {
+        if constexpr (std::ranges::common_range<V>) {
+            return iterator(*this, std::ranges::end(base_));
+        } else {
+            return sentinel(*this);
+        }
+    }
+};
+
+template <typename T>
+struct unwrap_or_fn {
+    JAC_NO_UNIQ_ADDR T fallback;
+
+    template <typename E>
+    constexpr auto operator()(E&& e) const {
+        using out =
+            std::common_type_t<std::remove_cvref_t<decltype(*std::forward<E>(
+                                   e))>,
+                               T>;
+        if (e.has_value()) { return out(*std::forward<E>(e)); }
+        return out(fallback);
+    }
+};
+
+} // namespace detail
+
+/// @brief A view of the values of a range of options or results, skipping
+/// empty options and errors
+///
+/// @details
+/// Each element is checked once while iterating, and the values are
+/// referenced rather than copied, unless the underlying range produces
+/// temporaries, in which case they are moved out.
+template <std::ranges::view V>
+using values_view = detail::select_view<V, detail::select_kind::values>;
+
+/// @brief A view of the errors of a range of results, skipping values
+template <std::ranges::view V>
+using errors_view = detail::select_view<V, detail::select_kind::errors>;
+
+/// @brief The values and errors of the same range of results, as returned by
+/// `views::partition_results`
+template <std::ranges::view V>
+struct partitioned_results {
+    values_view<V> values;
+    errors_view<V> errors;
+};
+
+namespace views {
+
+namespace detail {
+
+struct values_fn : ::jac::detail::view_closure<values_fn> {
+    template <std::ranges::viewable_range R>
+        requires ::jac::detail::selectable_range<
+            std::views::all_t<R>,
+            ::jac::detail::select_kind::values>
+    constexpr auto operator()(R&& r) const {
+        return values_view<std::views::all_t<R>>(
+            std::views::all(std::forward<R>(r)));
+    }
+};
+
+struct errors_fn : ::jac::detail::view_closure<errors_fn> {
+    template <std::ranges::viewable_range R>
+        requires ::jac::detail::selectable_range<
+            std::views::all_t<R>,
+            ::jac::detail::select_kind::errors>
+    constexpr auto operator()(R&& r) const {
+        return errors_view<std::views::all_t<R>>(
+            std::views::all(std::forward<R>(r)));
+    }
+};
+
+struct partition_results_fn
+    : ::jac::detail::view_closure<partition_results_fn> {
+    template <std::ranges::viewable_range R>
+        requires(std::ranges::forward_range<R> &&
+                 std::copyable<std::views::all_t<R>> &&
+                 ::jac::detail::selectable_range<
+                     std::views::all_t<R>,
+                     ::jac::detail::select_kind::errors>)
+    constexpr auto operator()(R&& r) const {
+        auto all = std::views::all(std::forward<R>(r));
+        return partitioned_results<decltype(all)>{
+            values_view<decltype(all)>(all), errors_view<decltype(all)>(all)};
+    }
+};
+
+template <typename T>
+struct unwrap_or_closure : ::jac::detail::view_closure<unwrap_or_closure<T>> {
+    JAC_NO_UNIQ_ADDR T fallback;
+
+    template <std::ranges::viewable_range R>
+        requires ::jac::detail::option_or_result<
+            std::ranges::range_reference_t<R>>
+    constexpr auto operator()(R&& r) const {
+        return std::views::transform(std::forward<R>(r),
+                                     ::jac::detail::unwrap_or_fn<T>{fallback});
+    }
+};
+
+struct unwrap_or_fn {
+    template <typename T>
+    constexpr auto operator()(T&& fallback) const {
+        return unwrap_or_closure<std::decay_t<T>>{{},
+                                                  std::forward<T>(fallback)};
+    }
+};
+
+} // namespace detail
+
+/// @brief Views the values of a range of options or results
+///
+/// @details
+/// `range | jac::views::values` skips empty options and errors, and yields
+/// references to the values.
+inline constexpr detail::values_fn values{};
+
+/// @brief Views the errors of a range of results
+inline constexpr detail::errors_fn errors{};
+
+/// @brief Views the values and the errors of a forward range of results
+///
+/// @details
+/// Returns a `partitioned_results` holding a `values_view` and an
+/// `errors_view` of the same range, which each make their own pass over it.
+/// ```
+/// auto [parsed, failed] = results | jac::views::partition_results;
+/// ```
+inline constexpr detail::partition_results_fn partition_results{};
+
+/// @brief Views a range of options or results as their values, replacing
+/// empty options and errors with `fallback`
+///
+/// @details
+/// The elements are produced by value, with the common type of the values
+/// and `fallback`.
+inline constexpr detail::unwrap_or_fn unwrap_or{};
+
+} // namespace views
+
+} // namespace jac
+
+#endif
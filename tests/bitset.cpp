@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/bitset.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace jac;
+
+TEST_CASE("bitset basics", "[bitset]") {
+    bitset bits(130);
+    REQUIRE(bits.size() == 130);
+    REQUIRE(bits.none());
+    REQUIRE(!bits.find_first_set().has_value());
+
+    bits.set(0);
+    bits.set(64);
+    bits.set(129);
+    REQUIRE(bits.test(64));
+    REQUIRE(!bits[63]);
+    REQUIRE(bits.count() == 3);
+    REQUIRE(*bits.find_first_set() == 0);
+    REQUIRE(*bits.find_next_set(1) == 64);
+    REQUIRE(*bits.find_next_set(65) == 129);
+    REQUIRE(!bits.find_next_set(130).has_value());
+    REQUIRE(*bits.find_next_unset(0) == 1);
+
+    bits.flip();
+    REQUIRE(bits.count() == 127);
+    REQUIRE(*bits.find_next_unset(1) == 64);
+    REQUIRE(!bits.find_next_unset(130).has_value());
+
+    bits.set();
+    REQUIRE(bits.all());
+    REQUIRE(!bits.find_next_unset(0).has_value());
+    bits.reset();
+    REQUIRE(bits.none());
+
+    bits.resize(200, true);
+    REQUIRE(bits.count() == 70);
+    REQUIRE(*bits.find_first_set() == 130);
+    bits.resize(10);
+    REQUIRE(bits.none());
+    REQUIRE(bits.words().size() == 1);
+}
+
+TEST_CASE("bitset bulk operations", "[bitset]") {
+    bitset a(1000);
+    bitset b(1000);
+    for (size_t i = 0; i < 1000; i += 2) { a.set(i); }
+    for (size_t i = 0; i < 1000; i += 3) { b.set(i); }
+
+    REQUIRE((a & b).count() == 167);
+    REQUIRE(a.count_and(b) == 167);
+    REQUIRE((a | b).count() == 500 + 334 - 167);
+    REQUIRE((a ^ b).count() == 500 + 334 - 2 * 167);
+    REQUIRE((~a).count() == 500);
+
+    auto c = a;
+    c.and_not(b);
+    REQUIRE(c.count() == 500 - 167);
+    REQUIRE(c != a);
+
+    std::vector<size_t> positions;
+    (a & b).for_each_set([&](size_t pos) { positions.push_back(pos); });
+    REQUIRE(positions.size() == 167);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        REQUIRE(positions[i] == i * 6);
+    }
+}
+
+TEST_CASE("bitset rank select", "[bitset]") {
+    std::mt19937_64 rng(7);
+    bitset bits(10000);
+    std::vector<size_t> set_positions;
+    for (size_t i = 0; i < bits.size(); ++i) {
+        if (rng() % 5 == 0) {
+            bits.set(i);
+            set_positions.push_back(i);
+        }
+    }
+
+    rank_select_index index(bits);
+    REQUIRE(index.count() == set_positions.size());
+    REQUIRE(index.size_in_bytes() > 0);
+    REQUIRE(index.size_in_bytes() < bits.words().size_bytes() / 4);
+    size_t rank = 0;
+    for (size_t i = 0; i <= bits.size(); ++i) {
+        REQUIRE(index.rank(i) == rank);
+        if (i < bits.size() && bits[i]) { ++rank; }
+    }
+    for (size_t k = 0; k < set_positions.size(); ++k) {
+        REQUIRE(*index.select(k) == set_positions[k]);
+    }
+    REQUIRE(!index.select(set_positions.size()).has_value());
+
+    size_t zeros = 0;
+    for (size_t i = 0; i < bits.size(); ++i) {
+        if (!bits[i]) { REQUIRE(*index.select_zero(zeros++) == i); }
+    }
+    REQUIRE(!index.select_zero(zeros).has_value());
+
+    bitset empty;
+    rank_select_index empty_index(empty);
+    REQUIRE(empty_index.rank(0) == 0);
+    REQUIRE(!empty_index.select(0).has_value());
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/bloom_filter.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+struct salted_hash {
+    uint64_t salt = 0;
+
+    size_t operator()(int key) const noexcept {
+        return static_cast<size_t>(hash_mix(uint64_t(key) ^ salt));
+    }
+
+    bool operator==(const salted_hash&) const = default;
+};
+
+} // namespace
+
+TEST_CASE("bloom_filter no false negatives", "[bloom_filter]") {
+    bloom_filter<uint64_t> filter(10000, 0.01);
+    for (uint64_t i = 0; i < 10000; ++i) { filter.insert(i * 7); }
+    for (uint64_t i = 0; i < 10000; ++i) { REQUIRE(filter.may_contain(i * 7)); }
+
+    size_t false_positives = 0;
+    for (uint64_t i = 0; i < 100000; ++i) {
+        false_positives += filter.may_contain(i * 7 + 1);
+    }
+    // Target is 1%, blocking costs a little accuracy
+    REQUIRE(false_positives < 3000);
+
+    filter.clear();
+    REQUIRE_FALSE(filter.may_contain(7));
+}
+
+TEST_CASE("bloom_filter may_contain_n", "[bloom_filter]") {
+    bloom_filter<std::string> filter(100);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 100; ++i) {
+        keys.push_back(std::to_string(i));
+        if (i % 2 == 0) { filter.insert(keys.back()); }
+    }
+
+    bool out[100];
+    auto hits = filter.may_contain_n(keys, out);
+    size_t expected = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(out[i] == filter.may_contain(keys[i]));
+        if (i % 2 == 0) { REQUIRE(out[i]); }
+        expected += out[i];
+    }
+    REQUIRE(hits == expected);
+}
+
+TEST_CASE("bloom_filter false positive rate", "[bloom_filter]") {
+    REQUIRE_THROWS_AS(bloom_filter<int>(100, 0.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(bloom_filter<int>(100, 1.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(bloom_filter<int>(100, -0.5), std::invalid_argument);
+    REQUIRE_THROWS_AS(bloom_filter<int>(100, std::nan("")),
+                      std::invalid_argument);
+    REQUIRE(bloom_filter<int>(100, 0.5).size_in_bytes() > 0);
+}
+
+TEST_CASE("bloom_filter merge", "[bloom_filter]") {
+    bloom_filter<int> a(100);
+    bloom_filter<int> b(100);
+    a.insert(1);
+    b.insert(2);
+    a.merge(b);
+    REQUIRE(a.may_contain(1));
+    REQUIRE(a.may_contain(2));
+
+    bloom_filter<int> smaller(10);
+    REQUIRE_THROWS_AS(a.merge(smaller), std::invalid_argument);
+    REQUIRE_THROWS_AS(smaller.merge(a), std::invalid_argument);
+
+    bloom_filter<int, salted_hash> c(100, 0.01, salted_hash{1});
+    bloom_filter<int, salted_hash> d(100, 0.01, salted_hash{2});
+    REQUIRE_THROWS_AS(c.merge(d), std::invalid_argument);
+    c.merge(bloom_filter<int, salted_hash>(100, 0.01, salted_hash{1}));
+}
@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/btree_map.hpp>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+template <typename Map, typename Ref>
+void require_same(const Map& map, const Ref& ref) {
+    REQUIRE(map.size() == ref.size());
+    auto it = map.begin();
+    for (auto& [key, value] : ref) {
+        REQUIRE(it != map.end());
+        REQUIRE(it->first == key);
+        REQUIRE(it->second == value);
+        ++it;
+    }
+    REQUIRE(it == map.end());
+}
+
+} // namespace
+
+TEST_CASE("btree_map insert and erase", "[btree_map]") {
+    btree_map<int, int, std::less<int>, 64> map;
+    std::map<int, int> ref;
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> dist(0, 2000);
+
+    for (int i = 0; i < 20000; ++i) {
+        auto key = dist(rng);
+        if (rng() % 3 == 0) {
+            auto removed = map.erase(key);
+            auto ref_it = ref.find(key);
+            if (ref_it == ref.end()) {
+                REQUIRE(!removed.has_value());
+            } else {
+                REQUIRE(removed.has_value());
+                REQUIRE(*removed == ref_it->second);
+                ref.erase(ref_it);
+            }
+        } else {
+            auto [it, inserted] = map.try_emplace(key, i);
+            auto [ref_it, ref_inserted] = ref.try_emplace(key, i);
+            REQUIRE(inserted == ref_inserted);
+            REQUIRE(it->second == ref_it->second);
+        }
+    }
+    require_same(map, ref);
+
+    for (auto& [key, value] : ref) { REQUIRE(*map.erase(key) == value); }
+    REQUIRE(map.empty());
+    REQUIRE(map.begin() == map.end());
+}
+
+TEST_CASE("btree_map lookup", "[btree_map]") {
+    btree_map<std::string, int, std::less<std::string>, 128> map;
+    for (int i = 0; i < 1000; i += 2) { map[std::to_string(i)] = i; }
+
+    REQUIRE(map.size() == 500);
+    REQUIRE(*map.find("42") == 42);
+    REQUIRE(!map.find("43").has_value());
+    REQUIRE(map.contains("998"));
+    REQUIRE(!map.contains("999"));
+
+    auto lb = map.lower_bound("43");
+    REQUIRE(lb.has_value());
+    REQUIRE((*lb)->first == "430");
+    auto ub = map.upper_bound("44");
+    REQUIRE(ub.has_value());
+    REQUIRE((*ub)->first == "440");
+    REQUIRE(!map.lower_bound("999").has_value());
+
+    map.insert_or_assign("42", -1);
+    REQUIRE(*map.find("42") == -1);
+}
+
+TEST_CASE("btree_map bulk load", "[btree_map]") {
+    std::vector<std::pair<long, std::string>> input;
+    std::map<long, std::string> ref;
+    for (long i = 0; i < 5000; ++i) {
+        input.emplace_back(i * 3, std::to_string(i));
+        ref.emplace(i * 3, std::to_string(i));
+    }
+
+    btree_map<long, std::string> map(sorted_unique, input.begin(),
+                                     input.end());
+    require_same(map, ref);
+
+    auto it = *map.lower_bound(301);
+    for (long key = 303; key < 400; key += 3) {
+        REQUIRE(it->first == key);
+        ++it;
+    }
+
+    auto copy = map;
+    require_same(copy, ref);
+
+    for (long i = 0; i < 15000; i += 2) {
+        map.erase(i);
+        ref.erase(i);
+    }
+    require_same(map, ref);
+    require_same(copy, std::map<long, std::string>(
+                           input.begin(), input.end()));
+}
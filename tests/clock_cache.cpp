@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/clock_cache.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+using namespace jac;
+
+namespace {
+
+struct fragile {
+    int value;
+
+    fragile(int v) : value(v) {}
+
+    fragile(const fragile& other) : value(other.value) {
+        if (value < 0) { throw std::runtime_error("copy failed"); }
+    }
+
+    fragile& operator=(const fragile&) = default;
+};
+
+} // namespace
+
+TEST_CASE("clock_cache basics", "[clock_cache]") {
+    REQUIRE_THROWS_AS((clock_cache<int, int>(0)), std::invalid_argument);
+
+    clock_cache<int, std::string> cache(3);
+    REQUIRE(cache.capacity() == 3);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+    REQUIRE(cache.size() == 3);
+    REQUIRE(*cache.peek(2) == "two");
+
+    // 1 gets a second chance, so 2 is evicted
+    REQUIRE(*cache.get(1) == "one");
+    cache.put(4, "four");
+    REQUIRE(cache.size() == 3);
+    REQUIRE(cache.contains(1));
+    REQUIRE(!cache.contains(2));
+    REQUIRE(cache.contains(3));
+    REQUIRE(cache.contains(4));
+
+    REQUIRE(*cache.erase(3) == "three");
+    REQUIRE(!cache.erase(3).has_value());
+    cache.put(5, "five");
+    REQUIRE(cache.size() == 3);
+    REQUIRE(cache.contains(1));
+    REQUIRE(cache.contains(4));
+
+    cache.clear();
+    REQUIRE(cache.empty());
+    REQUIRE(!cache.get(1).has_value());
+}
+
+TEST_CASE("clock_cache try_get_or_insert", "[clock_cache]") {
+    clock_cache<int, std::string> cache(2);
+    auto r = cache.try_get_or_insert(
+        1, []() -> result<std::string, int> { return std::string("made"); });
+    REQUIRE(*r == "made");
+    REQUIRE(*cache.peek(1) == "made");
+
+    auto err = cache.try_get_or_insert(
+        2, []() -> result<std::string, int> { return error<int>(3); });
+    REQUIRE(err.error() == 3);
+    REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("clock_cache random", "[clock_cache]") {
+    constexpr size_t capacity = 50;
+    clock_cache<int, int> cache(capacity);
+    std::unordered_map<int, int> model;
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> key_dist(0, 150);
+    for (int i = 0; i < 20000; ++i) {
+        int key = key_dist(rng);
+        switch (rng() % 3) {
+        case 0:
+            // Anything the cache still holds must have its latest value
+            if (auto value = cache.get(key)) { REQUIRE(*value == model[key]); }
+            break;
+        case 1:
+            cache.put(key, i);
+            model[key] = i;
+            REQUIRE(*cache.peek(key) == i);
+            break;
+        default:
+            cache.erase(key);
+            model.erase(key);
+            REQUIRE(!cache.contains(key));
+            break;
+        }
+        REQUIRE(cache.size() <= capacity);
+    }
+
+    size_t found = 0;
+    for (auto& [key, value] : model) {
+        if (auto cached = cache.peek(key)) {
+            REQUIRE(*cached == value);
+            ++found;
+        }
+    }
+    REQUIRE(found == cache.size());
+}
+
+TEST_CASE("clock_cache value construction throws", "[clock_cache]") {
+    clock_cache<int, fragile> cache(2);
+    cache.put(1, fragile(1));
+    REQUIRE_THROWS_AS(cache.put(2, fragile(-1)), std::runtime_error);
+    REQUIRE(cache.size() == 1);
+    REQUIRE(!cache.contains(2));
+
+    cache.put(3, fragile(3));
+    cache.put(4, fragile(4));
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.contains(4));
+    REQUIRE(int(cache.contains(1)) + int(cache.contains(3)) == 1);
+    for (int i = 5; i < 20; ++i) { cache.put(i, fragile(i)); }
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.peek(19)->value == 19);
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/collect.hpp>
+
+#include <list>
+#include <memory>
+#include <ranges>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+using parsed = result<int, std::string>;
+
+parsed parse(const std::string& s) {
+    if (s.empty() || s.find_first_not_of("0123456789") != std::string::npos) {
+        return error<std::string>(s);
+    }
+    return std::stoi(s);
+}
+
+} // namespace
+
+TEST_CASE("collect values", "[collect]") {
+    std::vector<parsed> rs{1, 2, 3};
+    auto all = collect<std::vector>(rs);
+    REQUIRE(all.has_value());
+    REQUIRE(*all == std::vector<int>{1, 2, 3});
+    REQUIRE(all->capacity() == 3);
+
+    auto set = collect<std::set<int>>(std::vector<parsed>{3, 1, 3});
+    REQUIRE(*set == std::set<int>{1, 3});
+
+    auto empty = collect<std::vector>(std::vector<parsed>());
+    REQUIRE(empty.has_value());
+    REQUIRE(empty->empty());
+}
+
+TEST_CASE("collect first error", "[collect]") {
+    int visited = 0;
+    std::vector<std::string> words{"1", "x", "2", "y"};
+    auto counted = words | std::views::transform([&](const std::string& s) {
+                       ++visited;
+                       return parse(s);
+                   });
+    auto all = collect<std::list>(counted);
+    REQUIRE(!all.has_value());
+    REQUIRE(all.error() == "x");
+    REQUIRE(visited == 2);
+}
+
+TEST_CASE("collect moves", "[collect]") {
+    using owned = result<std::unique_ptr<int>, int>;
+    std::vector<owned> rs;
+    rs.emplace_back(std::make_unique<int>(1));
+    rs.emplace_back(std::make_unique<int>(2));
+    auto all = collect<std::vector>(std::move(rs));
+    REQUIRE(all.has_value());
+    REQUIRE(*(*all)[1] == 2);
+}
+
+TEST_CASE("collect try_transform", "[collect]") {
+    std::vector<std::string> good{"4", "5", "6"};
+    auto ok = try_transform(good, parse);
+    REQUIRE(ok.has_value());
+    REQUIRE(*ok == std::vector<int>{4, 5, 6});
+
+    int calls = 0;
+    std::vector<std::string> bad{"7", "", "8"};
+    auto failed = try_transform<std::list>(bad, [&](const std::string& s) {
+        ++calls;
+        return parse(s);
+    });
+    REQUIRE(!failed.has_value());
+    REQUIRE(failed.error().empty());
+    REQUIRE(calls == 2);
+
+    auto squares = try_transform(std::views::iota(1, 4), [](int i) {
+        return result<int, std::string>(i * i);
+    });
+    REQUIRE(*squares == std::vector<int>{1, 4, 9});
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/compressed_sorted_seq.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace jac;
+
+TEST_CASE("compressed_sorted_seq decode", "[compressed_sorted_seq]") {
+    compressed_sorted_seq empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.begin() == empty.end());
+    REQUIRE(!empty.next_geq(0).has_value());
+
+    compressed_sorted_seq small{0, 0, 3, 5, 5, 100};
+    REQUIRE(small.size() == 6);
+    std::vector<uint64_t> decoded(small.begin(), small.end());
+    REQUIRE(decoded == std::vector<uint64_t>{0, 0, 3, 5, 5, 100});
+    REQUIRE(small[3] == 5);
+    REQUIRE(small[5] == 100);
+
+    std::vector<uint64_t> unsorted{3, 1};
+    REQUIRE_THROWS_AS(compressed_sorted_seq(unsorted), std::invalid_argument);
+}
+
+TEST_CASE("compressed_sorted_seq next_geq", "[compressed_sorted_seq]") {
+    std::mt19937_64 rng(11);
+    std::vector<uint64_t> values;
+    uint64_t v = 0;
+    for (int i = 0; i < 20000; ++i) {
+        v += rng() % 1000;
+        values.push_back(v);
+    }
+    compressed_sorted_seq seq(values);
+    REQUIRE(seq.size() == values.size());
+    REQUIRE(seq.size_in_bytes() < values.size() * 2);
+    REQUIRE(std::equal(seq.begin(), seq.end(), values.begin(), values.end()));
+
+    for (int i = 0; i < 5000; ++i) {
+        auto x = rng() % (v + 10);
+        auto it = std::lower_bound(values.begin(), values.end(), x);
+        auto found = seq.next_geq(x);
+        if (it == values.end()) {
+            REQUIRE(!found.has_value());
+        } else {
+            REQUIRE(*found == *it);
+        }
+    }
+    REQUIRE(*seq.next_geq(0) == values.front());
+    REQUIRE(*seq.next_geq(v) == v);
+
+    auto copy = seq;
+    REQUIRE(copy == seq);
+    REQUIRE(*copy.next_geq(values[1234]) == values[1234]);
+    auto moved = std::move(copy);
+    REQUIRE(moved[77] == values[77]);
+}
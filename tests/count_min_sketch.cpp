@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/count_min_sketch.hpp>
+#include <jac/result.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+using namespace jac;
+
+TEST_CASE("count_min_sketch estimate", "[count_min_sketch]") {
+    auto cms = count_min_sketch<uint64_t>::with_error(0.001, 0.01);
+    REQUIRE(cms.depth() == 5);
+
+    // Key `i` occurs `i` times for the first 1000 keys
+    for (uint64_t i = 1; i <= 1000; ++i) { cms.add(i, i); }
+    REQUIRE(cms.total() == 500500);
+
+    size_t exact = 0;
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        auto est = cms.estimate(i);
+        REQUIRE(est >= i);
+        REQUIRE(est <= i + 501);
+        exact += est == i;
+    }
+    REQUIRE(exact > 900);
+    REQUIRE(cms.estimate(5000) <= 501);
+
+    cms.clear();
+    REQUIRE(cms.estimate(1000) == 0);
+    REQUIRE(cms.total() == 0);
+}
+
+TEST_CASE("count_min_sketch merge", "[count_min_sketch]") {
+    count_min_sketch<std::string> a(256, 4);
+    count_min_sketch<std::string> b(256, 4);
+    for (int i = 0; i < 10; ++i) {
+        a.add("x");
+        b.add("x", 2);
+    }
+    b.add("y", 7);
+    a.merge(b);
+    REQUIRE(a.estimate("x") == 30);
+    REQUIRE(a.estimate("y") == 7);
+    REQUIRE(a.total() == 37);
+
+    REQUIRE_THROWS_AS(a.merge(count_min_sketch<std::string>(128, 4)),
+                      std::invalid_argument);
+}
+
+TEST_CASE("count_min_sketch with_error", "[count_min_sketch]") {
+    auto sketch = count_min_sketch<int>::with_error(0.01, 0.01);
+    REQUIRE(sketch.width() == 272);
+    REQUIRE(sketch.depth() == 5);
+
+    using sketch_t = count_min_sketch<int>;
+    REQUIRE_THROWS_AS(sketch_t::with_error(0.0, 0.01), std::invalid_argument);
+    REQUIRE_THROWS_AS(sketch_t::with_error(1.0, 0.01), std::invalid_argument);
+    REQUIRE_THROWS_AS(sketch_t::with_error(0.01, 0.0), std::invalid_argument);
+    REQUIRE_THROWS_AS(sketch_t::with_error(0.01, 1.5), std::invalid_argument);
+    REQUIRE_THROWS_AS(sketch_t::with_error(1e-12, 0.01),
+                      std::invalid_argument);
+}
+
+TEST_CASE("count_min_sketch serialize", "[count_min_sketch]") {
+    using key = result<int, std::string>;
+    count_min_sketch<key> cms(64, 3);
+    cms.add(key(1), 3);
+    cms.add(key(error<std::string>("oops")), 5);
+
+    auto bytes = cms.serialize();
+    REQUIRE(bytes.size() == 16 + 64 * 3 * 8);
+    auto copy = count_min_sketch<key>::deserialize(bytes);
+    REQUIRE(copy.has_value());
+    REQUIRE(copy->total() == 8);
+    REQUIRE(copy->estimate(key(1)) == 3);
+    REQUIRE(copy->estimate(key(error<std::string>("oops"))) == 5);
+
+    bytes.pop_back();
+    REQUIRE_FALSE(count_min_sketch<key>::deserialize(bytes).has_value());
+}
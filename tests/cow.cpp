@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/cow.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+struct counted {
+    static inline int copies = 0;
+
+    std::vector<int> data;
+
+    counted(std::initializer_list<int> ilist) : data(ilist) {}
+    counted(const counted& other) : data(other.data) { ++copies; }
+    counted& operator=(const counted&) = default;
+};
+
+} // namespace
+
+TEST_CASE("cow sharing", "[cow]") {
+    STATIC_REQUIRE(is_trivially_relocatable_v<cow<std::string>>);
+    counted::copies = 0;
+
+    cow<counted> a(std::in_place, {1, 2, 3});
+    REQUIRE(a.is_unique());
+
+    auto b = a;
+    auto c = b;
+    REQUIRE(a.use_count() == 3);
+    REQUIRE(counted::copies == 0);
+    REQUIRE(&std::as_const(a)->data == &std::as_const(c)->data);
+
+    b->data.push_back(4);
+    REQUIRE(counted::copies == 1);
+    REQUIRE(b.is_unique());
+    REQUIRE(a.use_count() == 2);
+    REQUIRE(std::as_const(a)->data.size() == 3);
+    REQUIRE(std::as_const(b)->data.size() == 4);
+
+    // Unique values are modified in place
+    b->data.push_back(5);
+    REQUIRE(counted::copies == 1);
+
+    auto ref = c.as_ref();
+    REQUIRE(counted::copies == 2);
+    ref->data.clear();
+    REQUIRE(std::as_const(a)->data.size() == 3);
+    REQUIRE(std::as_const(c)->data.empty());
+
+    auto moved = std::move(a);
+    REQUIRE(a.use_count() == 0);
+    REQUIRE(moved.is_unique());
+    a = moved;
+    REQUIRE(a.use_count() == 2);
+}
+
+TEST_CASE("cow assignment and comparison", "[cow]") {
+    cow<std::string, local_refcount> a("hello");
+    auto b = a;
+    REQUIRE(a == b);
+
+    b = "world";
+    REQUIRE(*std::as_const(a) == "hello");
+    REQUIRE(*std::as_const(b) == "world");
+    REQUIRE(a < b);
+    REQUIRE(a.is_unique());
+
+    a = "hi";
+    REQUIRE(*std::as_const(a) == "hi");
+
+    swap(a, b);
+    REQUIRE(*std::as_const(a) == "world");
+
+    auto c = b;
+    std::string taken = std::move(c).value();
+    REQUIRE(taken == "hi");
+    REQUIRE(*std::as_const(b) == "hi");
+
+    REQUIRE(std::hash<cow<std::string, local_refcount>>()(b) ==
+            std::hash<std::string>()("hi"));
+}
+
+TEST_CASE("cow threads", "[cow]") {
+    const cow<std::vector<int>> shared(std::in_place, 1000, 7);
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&shared, &failures, t] {
+            for (int i = 0; i < 200; ++i) {
+                auto local = shared;
+                if (i % 10 == 0) {
+                    local->push_back(t);
+                    if (local->size() != 1001) { ++failures; }
+                }
+                if ((*shared)[999] != 7) { ++failures; }
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    REQUIRE(failures == 0);
+    REQUIRE(shared.is_unique());
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/cuckoo_filter.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace jac;
+
+TEST_CASE("cuckoo_filter insert and query", "[cuckoo_filter]") {
+    cuckoo_filter<uint64_t> filter(10000);
+    for (uint64_t i = 0; i < 10000; ++i) { REQUIRE(filter.insert(i * 3)); }
+    REQUIRE(filter.size() == 10000);
+    for (uint64_t i = 0; i < 10000; ++i) { REQUIRE(filter.may_contain(i * 3)); }
+
+    size_t false_positives = 0;
+    for (uint64_t i = 0; i < 100000; ++i) {
+        false_positives += filter.may_contain(i * 3 + 1);
+    }
+    REQUIRE(false_positives < 100);
+}
+
+TEST_CASE("cuckoo_filter erase", "[cuckoo_filter]") {
+    cuckoo_filter<int> filter(1000);
+    for (int i = 0; i < 1000; ++i) { filter.insert(i); }
+    for (int i = 0; i < 1000; i += 2) { REQUIRE(filter.erase(i)); }
+    REQUIRE(filter.size() == 500);
+    for (int i = 1; i < 1000; i += 2) { REQUIRE(filter.may_contain(i)); }
+
+    size_t remaining = 0;
+    for (int i = 0; i < 1000; i += 2) { remaining += filter.may_contain(i); }
+    REQUIRE(remaining < 10);
+
+    filter.clear();
+    REQUIRE(filter.empty());
+    REQUIRE_FALSE(filter.may_contain(1));
+}
+
+TEST_CASE("cuckoo_filter full", "[cuckoo_filter]") {
+    cuckoo_filter<int> filter(64);
+    std::vector<int> inserted;
+    for (int i = 0; i < 1000 && !filter.full(); ++i) {
+        REQUIRE(filter.insert(i));
+        inserted.push_back(i);
+    }
+    REQUIRE(filter.full());
+    REQUIRE_FALSE(filter.insert(-1));
+    for (auto key : inserted) { REQUIRE(filter.may_contain(key)); }
+}
+
+TEST_CASE("cuckoo_filter may_contain_n", "[cuckoo_filter]") {
+    cuckoo_filter<int> filter(100);
+    std::vector<int> keys;
+    for (int i = 0; i < 100; ++i) {
+        keys.push_back(i);
+        if (i % 3 == 0) { filter.insert(i); }
+    }
+
+    bool out[100];
+    auto hits = filter.may_contain_n(keys, out);
+    size_t expected = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(out[i] == filter.may_contain(keys[i]));
+        expected += out[i];
+    }
+    REQUIRE(hits == expected);
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/dary_heap.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace jac;
+
+TEST_CASE("dary_heap basics", "[dary_heap]") {
+    dary_heap<int> heap{5, 3, 8, 1, 9, 2};
+    REQUIRE(heap.size() == 6);
+    REQUIRE(*heap.top() == 1);
+    heap.push(0);
+    heap.emplace(7);
+
+    std::vector<int> out;
+    while (auto v = heap.pop()) { out.push_back(*v); }
+    REQUIRE(out == std::vector<int>{0, 1, 2, 3, 5, 7, 8, 9});
+    REQUIRE(!heap.top().has_value());
+    REQUIRE(!heap.pop().has_value());
+
+    dary_heap<std::string, 3, std::greater<std::string>> max_heap;
+    max_heap.push("b");
+    max_heap.push("c");
+    max_heap.push("a");
+    REQUIRE(*max_heap.pop() == "c");
+    REQUIRE(*max_heap.pop() == "b");
+}
+
+TEST_CASE("dary_heap random", "[dary_heap]") {
+    std::mt19937 rng(1);
+    std::vector<int> values(5000);
+    for (auto& v : values) { v = static_cast<int>(rng() % 1000); }
+
+    dary_heap<int, 8> heap(values.begin(), values.end());
+    dary_heap<int, 2> pushed;
+    for (auto v : values) { pushed.push(v); }
+
+    std::sort(values.begin(), values.end());
+    for (auto v : values) {
+        REQUIRE(*heap.pop() == v);
+        REQUIRE(*pushed.pop() == v);
+    }
+    REQUIRE(heap.empty());
+}
+
+TEST_CASE("indexed_dary_heap basics", "[dary_heap]") {
+    indexed_dary_heap<int> heap;
+    auto ha = heap.push(10);
+    auto hb = heap.push(20);
+    auto hc = heap.push(30);
+    REQUIRE(*heap.top() == 10);
+    REQUIRE(*heap.top_handle() == ha);
+
+    REQUIRE(heap.decrease_key(hc, 5));
+    REQUIRE(*heap.top() == 5);
+    REQUIRE(*heap.top_handle() == hc);
+    REQUIRE_THROWS_AS(heap.decrease_key(hc, 50), std::invalid_argument);
+
+    REQUIRE(heap.update(hc, 40));
+    REQUIRE(*heap.get(hc) == 40);
+    REQUIRE(*heap.top() == 10);
+
+    REQUIRE(*heap.erase(ha) == 10);
+    REQUIRE(!heap.contains(ha));
+    REQUIRE(!heap.erase(ha).has_value());
+    REQUIRE(!heap.decrease_key(ha, 1));
+
+    // The freed slot is reused without reviving the old handle
+    auto hd = heap.push(1);
+    REQUIRE(!heap.contains(ha));
+    REQUIRE(*heap.pop() == 1);
+    REQUIRE(!heap.contains(hd));
+    REQUIRE(*heap.pop() == 20);
+    REQUIRE(*heap.pop() == 40);
+    REQUIRE(!heap.contains(hb));
+    REQUIRE(heap.empty());
+
+    heap.push(3);
+    auto he = heap.push(4);
+    heap.clear();
+    REQUIRE(!heap.contains(he));
+    REQUIRE(heap.empty());
+}
+
+TEST_CASE("indexed_dary_heap dijkstra", "[dary_heap]") {
+    // Random graph, checked against Bellman-Ford
+    constexpr int n = 200;
+    std::mt19937 rng(7);
+    std::vector<std::vector<std::pair<int, uint64_t>>> adj(n);
+    for (int i = 0; i < n * 5; ++i) {
+        adj[rng() % n].emplace_back(static_cast<int>(rng() % n), rng() % 100);
+    }
+
+    constexpr auto inf = std::numeric_limits<uint64_t>::max();
+    std::vector<uint64_t> expected(n, inf);
+    expected[0] = 0;
+    for (int round = 0; round < n; ++round) {
+        for (int u = 0; u < n; ++u) {
+            if (expected[u] == inf) { continue; }
+            for (auto [v, w] : adj[u]) {
+                expected[v] = std::min(expected[v], expected[u] + w);
+            }
+        }
+    }
+
+    using item = std::pair<uint64_t, int>;
+    indexed_dary_heap<item> heap;
+    std::vector<indexed_dary_heap<item>::handle> handles(n);
+    std::vector<uint64_t> dist(n, inf);
+    dist[0] = 0;
+    handles[0] = heap.push({0, 0});
+    size_t max_size = 0;
+    while (auto top = heap.pop()) {
+        auto [d, u] = *top;
+        for (auto [v, w] : adj[u]) {
+            if (d + w >= dist[v]) { continue; }
+            dist[v] = d + w;
+            if (heap.contains(handles[v])) {
+                heap.decrease_key(handles[v], {dist[v], v});
+            } else {
+                handles[v] = heap.push({dist[v], v});
+            }
+        }
+        max_size = std::max(max_size, heap.size());
+    }
+    REQUIRE(dist == expected);
+    REQUIRE(max_size <= size_t(n));
+}
@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/function.hpp>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace jac;
+
+namespace {
+
+int add_one(int x) { return x + 1; }
+
+struct counted {
+    static inline int live = 0;
+    int value;
+
+    explicit counted(int v) : value(v) { ++live; }
+    counted(const counted& other) : value(other.value) { ++live; }
+    counted(counted&& other) noexcept : value(other.value) { ++live; }
+    ~counted() { --live; }
+
+    int operator()() const { return value; }
+};
+
+} // namespace
+
+TEST_CASE("inplace_function basics", "[function]") {
+    inplace_function<int(int)> empty;
+    REQUIRE(!empty);
+    REQUIRE(empty == nullptr);
+    REQUIRE_THROWS_AS(empty(1), std::bad_function_call);
+
+    inplace_function<int(int)> f = add_one;
+    REQUIRE(f);
+    REQUIRE(f(1) == 2);
+
+    int (*null_fn)(int) = nullptr;
+    f = null_fn;
+    REQUIRE(!f);
+
+    int base = 10;
+    f = [base](int x) { return base + x; };
+    REQUIRE(f(5) == 15);
+
+    // Move-only captures are supported
+    inplace_function<int()> g = [p = std::make_unique<int>(7)] { return *p; };
+    auto h = std::move(g);
+    REQUIRE(!g);
+    REQUIRE(h() == 7);
+
+    // Mutable state persists between calls
+    inplace_function<int()> counter = [n = 0]() mutable { return ++n; };
+    counter();
+    REQUIRE(counter() == 2);
+
+    inplace_function<void(std::string&)> append = [](std::string& s) {
+        s += "!";
+    };
+    std::string s = "hi";
+    append(s);
+    REQUIRE(s == "hi!");
+
+    swap(h, counter);
+    REQUIRE(h() == 3);
+    REQUIRE(counter() == 7);
+    h = nullptr;
+    REQUIRE(!h);
+}
+
+TEST_CASE("inplace_function lifetime", "[function]") {
+    {
+        inplace_function<int()> f = counted(3);
+        REQUIRE(counted::live == 1);
+        auto g = std::move(f);
+        REQUIRE(counted::live == 1);
+        REQUIRE(g() == 3);
+        g = counted(4);
+        REQUIRE(counted::live == 1);
+        REQUIRE(g() == 4);
+        g.reset();
+        REQUIRE(counted::live == 0);
+        g = counted(5);
+    }
+    REQUIRE(counted::live == 0);
+
+    STATIC_REQUIRE(inplace_function<void()>::is_inline<counted>);
+    STATIC_REQUIRE(!inplace_function<void(), 16>::is_inline<
+                   decltype([a = std::array<char, 64>{}] {})>);
+}
+
+TEST_CASE("function spills to the heap", "[function]") {
+    std::array<int, 32> big{};
+    big[31] = 9;
+    using small_function = function<int(), 16>;
+    STATIC_REQUIRE(!small_function::is_inline<decltype([big] { return 0; })>);
+
+    small_function f = [big] { return big[31]; };
+    REQUIRE(f() == 9);
+    auto g = std::move(f);
+    REQUIRE(!f);
+    REQUIRE(g() == 9);
+
+    {
+        function<int(), 16> c = counted(1);
+        REQUIRE(counted::live == 1);
+        function<int(), 16> d = std::move(c);
+        REQUIRE(counted::live == 1);
+        REQUIRE(d() == 1);
+    }
+    REQUIRE(counted::live == 0);
+
+    // Large callables still work, small ones stay inline
+    function<int(int)> small = [](int x) { return x * 2; };
+    REQUIRE(small(4) == 8);
+    function<std::string(std::string)> big_capture =
+        [big, suffix = std::string("?")](std::string s) {
+            return s + std::to_string(big[31]) + suffix;
+        };
+    REQUIRE(big_capture("x") == "x9?");
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/hive.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+struct fragile {
+    static inline int live = 0;
+    static inline int copies_left = 0;
+
+    int value;
+
+    explicit fragile(int v) : value(v) {
+        if (v < 0) { throw std::runtime_error("negative"); }
+        ++live;
+    }
+
+    fragile(const fragile& other) : value(other.value) {
+        if (copies_left-- == 0) { throw std::runtime_error("copy failed"); }
+        ++live;
+    }
+
+    ~fragile() { --live; }
+};
+
+} // namespace
+
+TEST_CASE("hive insert and erase", "[hive]") {
+    hive<std::string> h;
+    REQUIRE(h.empty());
+    REQUIRE(h.begin() == h.end());
+
+    std::vector<std::string*> ptrs;
+    for (int i = 0; i < 100; ++i) {
+        ptrs.push_back(&*h.insert(std::to_string(i)));
+    }
+    REQUIRE(h.size() == 100);
+
+    // Erase every other element, the rest must stay in place
+    for (int i = 0; i < 100; i += 2) { h.erase(h.get_iterator(ptrs[i])); }
+    REQUIRE(h.size() == 50);
+    for (int i = 1; i < 100; i += 2) { REQUIRE(*ptrs[i] == std::to_string(i)); }
+
+    std::multiset<std::string> seen(h.begin(), h.end());
+    REQUIRE(seen.size() == 50);
+    REQUIRE(seen.count("1") == 1);
+    REQUIRE(seen.count("2") == 0);
+
+    // Freed slots are reused before new blocks are allocated
+    auto capacity = h.capacity();
+    for (int i = 0; i < 50; ++i) { h.emplace("new"); }
+    REQUIRE(h.capacity() == capacity);
+    REQUIRE(h.size() == 100);
+    REQUIRE(std::count(h.begin(), h.end(), "new") == 50);
+
+    h.clear();
+    REQUIRE(h.empty());
+    REQUIRE(h.capacity() == 0);
+}
+
+TEST_CASE("hive iteration", "[hive]") {
+    hive<int> h{1, 2, 3, 4, 5};
+    auto it = h.begin();
+    it = h.erase(it);
+    REQUIRE(*it == 2);
+    it = h.erase(std::next(it, 3));
+    REQUIRE(it == h.end());
+    REQUIRE(*std::prev(it) == 4);
+
+    std::vector<int> values(h.begin(), h.end());
+    REQUIRE(values == std::vector<int>{2, 3, 4});
+    std::vector<int> reversed(std::make_reverse_iterator(h.end()),
+                              std::make_reverse_iterator(h.begin()));
+    REQUIRE(reversed == std::vector<int>{4, 3, 2});
+
+    const auto& ch = h;
+    hive<int>::const_iterator cit = h.begin();
+    REQUIRE(cit == ch.begin());
+
+    auto copy = h;
+    REQUIRE(std::vector<int>(copy.begin(), copy.end()) == values);
+    auto moved = std::move(copy);
+    REQUIRE(moved.size() == 3);
+    REQUIRE(copy.empty());
+}
+
+TEST_CASE("hive randomized", "[hive]") {
+    std::mt19937 rng(5);
+    hive<std::unique_ptr<int>> h;
+    std::multiset<int> expected;
+    std::vector<int*> live;
+
+    for (int round = 0; round < 20000; ++round) {
+        if (live.empty() || rng() % 3 != 0) {
+            int value = static_cast<int>(rng() % 1000);
+            live.push_back(h.emplace(std::make_unique<int>(value))->get());
+            expected.insert(value);
+        } else {
+            auto pick = rng() % live.size();
+            auto target = live[pick];
+            auto it = std::find_if(h.begin(), h.end(),
+                                   [&](auto& p) { return p.get() == target; });
+            REQUIRE(it != h.end());
+            expected.erase(expected.find(*target));
+            h.erase(it);
+            live[pick] = live.back();
+            live.pop_back();
+        }
+        if (round % 1000 == 0) {
+            std::multiset<int> actual;
+            for (auto& p : h) { actual.insert(*p); }
+            REQUIRE(actual == expected);
+            REQUIRE(h.size() == expected.size());
+
+            std::multiset<int> backward;
+            for (auto rit = h.end(); rit != h.begin();) {
+                --rit;
+                backward.insert(**rit);
+            }
+            REQUIRE(backward == expected);
+        }
+    }
+}
+
+TEST_CASE("hive exceptions", "[hive]") {
+    {
+        hive<fragile> h;
+        REQUIRE_THROWS_AS(h.emplace(-1), std::runtime_error);
+        REQUIRE(h.empty());
+        REQUIRE(h.capacity() == 0);
+        REQUIRE(h.begin() == h.end());
+
+        for (int i = 0; i < 8; ++i) { h.emplace(i); }
+        REQUIRE_THROWS_AS(h.emplace(-1), std::runtime_error);
+        REQUIRE(h.size() == 8);
+        REQUIRE(std::distance(h.begin(), h.end()) == 8);
+
+        fragile::copies_left = 3;
+        REQUIRE_THROWS_AS(hive<fragile>(h), std::runtime_error);
+        REQUIRE(fragile::live == 8);
+    }
+    REQUIRE(fragile::live == 0);
+}
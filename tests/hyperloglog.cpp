@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/hyperloglog.hpp>
+#include <jac/option.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace jac;
+
+namespace {
+
+bool within(uint64_t estimate, uint64_t actual, double tolerance) {
+    auto diff = estimate > actual ? estimate - actual : actual - estimate;
+    return static_cast<double>(diff) <= tolerance * static_cast<double>(actual);
+}
+
+} // namespace
+
+TEST_CASE("hyperloglog estimate", "[hyperloglog]") {
+    hyperloglog<uint64_t> hll;
+    REQUIRE(hll.estimate() == 0);
+    REQUIRE(hll.is_sparse());
+
+    for (uint64_t i = 0; i < 100; ++i) {
+        hll.insert(i);
+        hll.insert(i);
+    }
+    REQUIRE(hll.is_sparse());
+    REQUIRE(within(hll.estimate(), 100, 0.05));
+
+    for (uint64_t i = 0; i < 200000; ++i) { hll.insert(i); }
+    REQUIRE_FALSE(hll.is_sparse());
+    REQUIRE(within(hll.estimate(), 200000, 0.05));
+
+    hll.clear();
+    REQUIRE(hll.estimate() == 0);
+    REQUIRE_THROWS_AS(hyperloglog<int>(2), std::invalid_argument);
+}
+
+TEST_CASE("hyperloglog merge", "[hyperloglog]") {
+    hyperloglog<std::string> a(12);
+    hyperloglog<std::string> b(12);
+    hyperloglog<std::string> c(12);
+    for (int i = 0; i < 300; ++i) { a.insert(std::to_string(i)); }
+    for (int i = 200; i < 400; ++i) { b.insert(std::to_string(i)); }
+    for (int i = 0; i < 50000; ++i) { c.insert(std::to_string(i)); }
+
+    a.merge(b);
+    REQUIRE(a.is_sparse());
+    REQUIRE(within(a.estimate(), 400, 0.05));
+
+    a.merge(c);
+    REQUIRE_FALSE(a.is_sparse());
+    REQUIRE(within(a.estimate(), 50000, 0.05));
+
+    c.merge(b);
+    REQUIRE(within(c.estimate(), 50000, 0.05));
+
+    REQUIRE_THROWS_AS(a.merge(hyperloglog<std::string>(10)),
+                      std::invalid_argument);
+}
+
+TEST_CASE("hyperloglog serialize", "[hyperloglog]") {
+    hyperloglog<option<int>> hll(10);
+    hll.insert(null);
+    for (int i = 0; i < 50; ++i) { hll.insert(i); }
+
+    auto sparse = hll.serialize();
+    auto copy = hyperloglog<option<int>>::deserialize(sparse);
+    REQUIRE(copy.has_value());
+    REQUIRE(copy->is_sparse());
+    REQUIRE(copy->estimate() == hll.estimate());
+
+    for (int i = 0; i < 5000; ++i) { hll.insert(i); }
+    auto dense = hll.serialize();
+    REQUIRE(dense.size() == 2 + 1024);
+    copy = hyperloglog<option<int>>::deserialize(dense);
+    REQUIRE(copy.has_value());
+    REQUIRE(copy->estimate() == hll.estimate());
+
+    dense.pop_back();
+    REQUIRE_FALSE(hyperloglog<option<int>>::deserialize(dense).has_value());
+    sparse[0] = std::byte{7};
+    REQUIRE_FALSE(hyperloglog<option<int>>::deserialize(sparse).has_value());
+}
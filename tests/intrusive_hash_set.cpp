@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/intrusive_hash_set.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+struct session {
+    int id;
+    hash_set_hook hook;
+
+    friend bool operator==(const session& lhs, int rhs) noexcept {
+        return lhs.id == rhs;
+    }
+
+    friend bool operator==(const session& lhs, const session& rhs) noexcept {
+        return lhs.id == rhs.id;
+    }
+};
+
+struct session_hash {
+    size_t operator()(const session& s) const noexcept { return (*this)(s.id); }
+    size_t operator()(int id) const noexcept { return std::hash<int>{}(id); }
+};
+
+using session_set = intrusive_hash_set<session, &session::hook, session_hash>;
+
+} // namespace
+
+TEST_CASE("intrusive_hash_set basics", "[intrusive_hash_set]") {
+    std::vector<std::unique_ptr<session>> sessions;
+    for (int i = 0; i < 100; ++i) {
+        sessions.push_back(std::make_unique<session>(session{i, {}}));
+    }
+
+    session_set set;
+    for (auto& s : sessions) { REQUIRE(set.insert(*s)); }
+    REQUIRE(set.size() == 100);
+    REQUIRE(set.bucket_count() >= 100);
+
+    session dup{5, {}};
+    REQUIRE_FALSE(set.insert(dup));
+    REQUIRE(!dup.hook.is_linked());
+
+    REQUIRE(&*set.find(42) == sessions[42].get());
+    REQUIRE(set.contains(*sessions[7]));
+    REQUIRE(!set.find(1000).has_value());
+
+    set.erase(*sessions[42]);
+    REQUIRE(!set.contains(42));
+    REQUIRE(!sessions[42]->hook.is_linked());
+    REQUIRE(set.extract(43)->id == 43);
+    REQUIRE(!set.extract(43).has_value());
+    REQUIRE(set.size() == 98);
+
+    std::set<int> seen;
+    for (const auto& s : set) { seen.insert(s.id); }
+    REQUIRE(seen.size() == 98);
+    REQUIRE(seen.count(42) == 0);
+
+    auto moved = std::move(set);
+    REQUIRE(set.empty());
+    REQUIRE(moved.contains(0));
+    moved.clear();
+    REQUIRE(!sessions[0]->hook.is_linked());
+}
+
+TEST_CASE("intrusive_hash_set reserve", "[intrusive_hash_set]") {
+    session_set set(1000);
+    auto buckets = set.bucket_count();
+    std::vector<session> sessions(1000);
+    for (int i = 0; i < 1000; ++i) {
+        sessions[i].id = i;
+        set.insert(sessions[i]);
+    }
+    REQUIRE(set.bucket_count() == buckets);
+    for (int i = 0; i < 1000; ++i) { REQUIRE(set.find(i)->id == i); }
+    set.clear();
+}
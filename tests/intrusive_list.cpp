@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/intrusive_list.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+struct connection {
+    int id;
+    list_hook state_hook;
+    list_hook timeout_hook;
+};
+
+using state_list = intrusive_list<connection, &connection::state_hook>;
+using timeout_list = intrusive_list<connection, &connection::timeout_hook>;
+
+template <typename List>
+std::vector<int> ids(const List& list) {
+    std::vector<int> out;
+    for (const auto& conn : list) { out.push_back(conn.id); }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("intrusive_list basics", "[intrusive_list]") {
+    std::vector<connection> conns(5);
+    for (int i = 0; i < 5; ++i) { conns[i].id = i; }
+
+    state_list idle;
+    state_list active;
+    timeout_list timeouts;
+    REQUIRE(!idle.front().has_value());
+    REQUIRE(!idle.pop_back().has_value());
+
+    for (auto& conn : conns) {
+        idle.push_back(conn);
+        timeouts.push_front(conn);
+    }
+    REQUIRE(idle.size() == 5);
+    REQUIRE(ids(idle) == std::vector<int>{0, 1, 2, 3, 4});
+    REQUIRE(ids(timeouts) == std::vector<int>{4, 3, 2, 1, 0});
+    REQUIRE(conns[2].state_hook.is_linked());
+
+    idle.erase(conns[2]);
+    active.push_back(conns[2]);
+    REQUIRE(ids(idle) == std::vector<int>{0, 1, 3, 4});
+    REQUIRE(ids(active) == std::vector<int>{2});
+    REQUIRE(timeouts.size() == 5);
+
+    idle.move_to_back(conns[0]);
+    idle.move_to_front(conns[4]);
+    REQUIRE(ids(idle) == std::vector<int>{4, 1, 3, 0});
+    REQUIRE(idle.front()->id == 4);
+    REQUIRE(idle.back()->id == 0);
+
+    REQUIRE(idle.pop_front()->id == 4);
+    REQUIRE(!conns[4].state_hook.is_linked());
+    auto it = idle.erase(state_list::iterator_to(conns[1]));
+    REQUIRE(it->id == 3);
+    idle.insert(it, conns[4]);
+    REQUIRE(ids(idle) == std::vector<int>{4, 3, 0});
+
+    auto moved = std::move(idle);
+    REQUIRE(idle.empty());
+    REQUIRE(ids(moved) == std::vector<int>{4, 3, 0});
+    moved.swap(active);
+    REQUIRE(ids(moved) == std::vector<int>{2});
+    REQUIRE(ids(active) == std::vector<int>{4, 3, 0});
+
+    active.clear();
+    moved.clear();
+    timeouts.clear();
+    REQUIRE(!conns[3].state_hook.is_linked());
+    REQUIRE(!conns[3].timeout_hook.is_linked());
+}
@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/lru_cache.hpp>
+
+#include <cstddef>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+using namespace jac;
+
+namespace {
+
+struct length_cost {
+    size_t operator()(int, const std::string& value) const noexcept {
+        return value.size();
+    }
+};
+
+struct tracked {
+    static inline int live = 0;
+
+    int value;
+
+    tracked(int v) : value(v) { ++live; }
+
+    tracked(const tracked& other) : value(other.value) { ++live; }
+
+    tracked& operator=(const tracked&) = default;
+
+    ~tracked() { --live; }
+};
+
+struct picky_cost {
+    size_t operator()(int, const tracked& t) const {
+        if (t.value < 0) { throw std::invalid_argument("negative"); }
+        return 1;
+    }
+};
+
+} // namespace
+
+TEST_CASE("lru_cache eviction order", "[lru_cache]") {
+    lru_cache<int, std::string> cache(3);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+    REQUIRE(cache.size() == 3);
+
+    // Touching 1 makes 2 the least recently used
+    REQUIRE(*cache.get(1) == "one");
+    cache.put(4, "four");
+    REQUIRE(cache.size() == 3);
+    REQUIRE(!cache.contains(2));
+    REQUIRE(cache.contains(1));
+
+    // peek does not refresh, so 3 is evicted next even after peeking
+    REQUIRE(*cache.peek(3) == "three");
+    cache.put(5, "five");
+    REQUIRE(!cache.contains(3));
+
+    // Replacing a value refreshes it
+    REQUIRE(cache.put(1, "uno") == "uno");
+    cache.put(6, "six");
+    REQUIRE(cache.contains(1));
+    REQUIRE(!cache.contains(4));
+
+    REQUIRE(*cache.erase(5) == "five");
+    REQUIRE(!cache.erase(5).has_value());
+    REQUIRE(cache.size() == 2);
+
+    cache.clear();
+    REQUIRE(cache.empty());
+    REQUIRE(!cache.get(1).has_value());
+}
+
+TEST_CASE("lru_cache cost", "[lru_cache]") {
+    lru_cache<int, std::string, std::hash<int>, std::equal_to<int>,
+              length_cost>
+        cache(10);
+    cache.put(1, "aaaa");
+    cache.put(2, "bbbb");
+    REQUIRE(cache.total_cost() == 8);
+
+    cache.put(3, "cccc");
+    REQUIRE(!cache.contains(1));
+    REQUIRE(cache.total_cost() == 8);
+
+    // Growing a value evicts others to make room
+    cache.put(3, "cccccccc");
+    REQUIRE(!cache.contains(2));
+    REQUIRE(cache.total_cost() == 8);
+
+    // An oversized entry is kept alone
+    cache.put(4, std::string(20, 'd'));
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.total_cost() == 20);
+    REQUIRE(cache.peek(4)->size() == 20);
+
+    cache.erase(4);
+    REQUIRE(cache.total_cost() == 0);
+}
+
+TEST_CASE("lru_cache try_get_or_insert", "[lru_cache]") {
+    lru_cache<int, std::string> cache(2);
+    int calls = 0;
+    auto make = [&]() -> result<std::string, int> {
+        ++calls;
+        return std::string("made");
+    };
+
+    auto r = cache.try_get_or_insert(1, make);
+    REQUIRE(r.has_value());
+    REQUIRE(*r == "made");
+    REQUIRE(calls == 1);
+
+    *r = "changed";
+    REQUIRE(*cache.try_get_or_insert(1, make) == "changed");
+    REQUIRE(calls == 1);
+
+    auto err = cache.try_get_or_insert(
+        2, []() -> result<std::string, int> { return error<int>(7); });
+    REQUIRE(!err.has_value());
+    REQUIRE(err.error() == 7);
+    REQUIRE(!cache.contains(2));
+    REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("lru_cache random", "[lru_cache]") {
+    constexpr size_t capacity = 64;
+    lru_cache<int, int> cache(capacity);
+    std::list<std::pair<int, int>> order;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> model;
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> key_dist(0, 200);
+    for (int i = 0; i < 20000; ++i) {
+        int key = key_dist(rng);
+        auto it = model.find(key);
+        switch (rng() % 3) {
+        case 0: {
+            auto value = cache.get(key);
+            REQUIRE(value.has_value() == (it != model.end()));
+            if (value) {
+                REQUIRE(*value == it->second->second);
+                order.splice(order.begin(), order, it->second);
+            }
+            break;
+        }
+        case 1:
+            cache.put(key, i);
+            if (it != model.end()) {
+                it->second->second = i;
+                order.splice(order.begin(), order, it->second);
+            } else {
+                order.emplace_front(key, i);
+                model[key] = order.begin();
+                if (order.size() > capacity) {
+                    model.erase(order.back().first);
+                    order.pop_back();
+                }
+            }
+            break;
+        default:
+            REQUIRE(cache.erase(key).has_value() == (it != model.end()));
+            if (it != model.end()) {
+                order.erase(it->second);
+                model.erase(it);
+            }
+            break;
+        }
+        REQUIRE(cache.size() == model.size());
+    }
+    for (auto& [key, value] : order) { REQUIRE(*cache.peek(key) == value); }
+}
+
+TEST_CASE("lru_cache cost throws", "[lru_cache]") {
+    {
+        lru_cache<int, tracked, std::hash<int>, std::equal_to<int>, picky_cost>
+            cache(2);
+        cache.put(1, tracked(1));
+        REQUIRE_THROWS_AS(cache.put(2, tracked(-1)), std::invalid_argument);
+        REQUIRE(cache.size() == 1);
+        REQUIRE(!cache.contains(2));
+        REQUIRE(tracked::live == 1);
+
+        cache.put(3, tracked(3));
+        cache.put(4, tracked(4));
+        REQUIRE(!cache.contains(1));
+        REQUIRE(tracked::live == 2);
+    }
+    REQUIRE(tracked::live == 0);
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/packed_int_vector.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace jac;
+
+TEST_CASE("packed_int_vector fixed width", "[packed_int_vector]") {
+    packed_int_vector<11> vec;
+    REQUIRE(vec.width() == 11);
+    REQUIRE(vec.max_value() == 2047);
+    for (uint64_t i = 0; i < 1000; ++i) { vec.push_back(i * 7 % 2048); }
+    REQUIRE(vec.size() == 1000);
+    REQUIRE(vec.size_in_bytes() < 1000 * 2);
+    for (uint64_t i = 0; i < 1000; ++i) { REQUIRE(vec[i] == i * 7 % 2048); }
+
+    vec.set(5, 4096 + 3);
+    REQUIRE(vec[5] == 3);
+    REQUIRE(vec[4] == 28);
+    REQUIRE(vec[6] == 42);
+
+    auto copy = vec;
+    REQUIRE(copy == vec);
+    copy.set(999, 0);
+    REQUIRE(copy != vec);
+
+    vec.resize(10);
+    vec.resize(20);
+    REQUIRE(vec[9] == 63);
+    REQUIRE(vec[10] == 0);
+    REQUIRE(vec[19] == 0);
+}
+
+TEST_CASE("packed_int_vector runtime width", "[packed_int_vector]") {
+    REQUIRE_THROWS_AS(packed_int_vector<>(0, 65), std::invalid_argument);
+
+    std::mt19937_64 rng(3);
+    for (size_t width : {1, 7, 17, 32, 63, 64}) {
+        packed_int_vector<> vec(300, width);
+        std::vector<uint64_t> expected(300);
+        for (size_t i = 0; i < 300; ++i) {
+            expected[i] = rng() & vec.max_value();
+            vec.set(i, expected[i]);
+        }
+        for (size_t i = 0; i < 300; ++i) { REQUIRE(vec[i] == expected[i]); }
+
+        std::vector<uint64_t> out(250);
+        vec.unpack(13, std::span(out));
+        for (size_t i = 0; i < out.size(); ++i) {
+            REQUIRE(out[i] == expected[i + 13]);
+        }
+    }
+}
+
+TEST_CASE("packed_int_vector unpack", "[packed_int_vector]") {
+    packed_int_vector<20> vec(1000);
+    for (uint64_t i = 0; i < 1000; ++i) { vec.set(i, i * 1021); }
+
+    std::vector<uint32_t> out(1000);
+    vec.unpack(0, std::span(out));
+    for (uint64_t i = 0; i < 1000; ++i) { REQUIRE(out[i] == i * 1021); }
+
+    std::vector<uint32_t> part(130);
+    vec.unpack(64, std::span(part));
+    for (uint64_t i = 0; i < 130; ++i) {
+        REQUIRE(part[i] == (i + 64) * 1021);
+    }
+
+    vec.unpack(1000, std::span(part).first(0));
+}
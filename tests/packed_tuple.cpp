@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/packed_tuple.hpp>
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+
+using namespace jac;
+
+namespace {
+
+struct empty {
+    friend bool operator==(empty, empty) = default;
+    friend auto operator<=>(empty, empty) = default;
+};
+
+} // namespace
+
+TEST_CASE("packed_tuple layout", "[packed_tuple]") {
+    STATIC_REQUIRE(sizeof(packed_tuple<bool, uint64_t, uint8_t, uint32_t>) ==
+                   16);
+    STATIC_REQUIRE(sizeof(packed_tuple<uint8_t, uint32_t, uint8_t>) == 8);
+    STATIC_REQUIRE(sizeof(packed_tuple<uint32_t, empty, void>) == 4);
+    STATIC_REQUIRE(
+        is_trivially_relocatable_v<packed_tuple<uint8_t, int*>>);
+
+    packed_tuple<bool, uint64_t, uint8_t, uint32_t> t(true, 1ull << 40, 7, 9);
+    REQUIRE(get<0>(t));
+    REQUIRE(get<1>(t) == 1ull << 40);
+    REQUIRE(get<2>(t) == 7);
+    REQUIRE(get<3>(t) == 9);
+
+    get<2>(t) = 8;
+    REQUIRE(t.get<2>() == 8);
+
+    auto [a, b, c, d] = t;
+    REQUIRE(a);
+    REQUIRE(b == 1ull << 40);
+    REQUIRE(c == 8);
+    REQUIRE(d == 9);
+}
+
+TEST_CASE("packed_tuple elements", "[packed_tuple]") {
+    int x = 1;
+    packed_tuple<int&, std::string, char> t(x, "hello", 'c');
+    get<0>(t) = 5;
+    REQUIRE(x == 5);
+
+    std::string moved = get<1>(std::move(t));
+    REQUIRE(moved == "hello");
+
+    packed_tuple<char, std::string> p('a', "b");
+    packed_tuple<char, std::string> q('a', "c");
+    REQUIRE(p != q);
+    REQUIRE(p < q);
+    REQUIRE(packed_tuple<char, std::string>('b', "a") > q);
+
+    swap(p, q);
+    REQUIRE(get<1>(p) == "c");
+
+    std::unordered_set<packed_tuple<uint8_t, uint64_t>> set;
+    set.emplace(uint8_t(1), uint64_t(2));
+    set.emplace(uint8_t(1), uint64_t(2));
+    set.emplace(uint8_t(2), uint64_t(1));
+    REQUIRE(set.size() == 2);
+
+    packed_tuple<> none;
+    REQUIRE(none == packed_tuple<>());
+    STATIC_REQUIRE(std::tuple_size_v<packed_tuple<int, void>> == 2);
+}
@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/parallel.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace jac;
+
+TEST_CASE("parallel try_transform", "[parallel]") {
+    std::vector<int> input(10000);
+    std::iota(input.begin(), input.end(), 0);
+    std::vector<long> output(input.size());
+
+    auto ok = parallel_try_transform(
+        input, output.begin(),
+        [](int i) { return result<long, std::string>(long(i) * 2); },
+        {.threads = 4, .chunk_size = 64});
+    REQUIRE(ok.has_value());
+    for (size_t i = 0; i < input.size(); ++i) {
+        REQUIRE(output[i] == long(i) * 2);
+    }
+
+    // A single thread and an empty input run on the calling thread
+    std::vector<int> none;
+    auto empty = parallel_try_transform(
+        none, output.begin(),
+        [](int i) { return result<long, std::string>(i); });
+    REQUIRE(empty.has_value());
+
+    auto single = parallel_try_transform(
+        input, output.begin(),
+        [](int i) { return result<long, std::string>(i); }, {.threads = 1});
+    REQUIRE(single.has_value());
+    REQUIRE(output.back() == 9999);
+}
+
+TEST_CASE("parallel first error by index", "[parallel]") {
+    std::vector<int> input(100000);
+    std::iota(input.begin(), input.end(), 0);
+    std::vector<int> output(input.size());
+    std::atomic<size_t> calls{0};
+
+    for (int run = 0; run < 20; ++run) {
+        calls = 0;
+        auto failed = parallel_try_transform(
+            input, output.begin(),
+            [&](int i) -> result<int, int> {
+                ++calls;
+                if (i == 50 || i == 70000) { return error<int>(i); }
+                return i;
+            },
+            {.threads = 8, .chunk_size = 16});
+        REQUIRE(!failed.has_value());
+        REQUIRE(failed.error() == 50);
+        REQUIRE(calls < input.size());
+    }
+}
+
+TEST_CASE("parallel first error by time", "[parallel]") {
+    std::vector<int> input(100000);
+    std::iota(input.begin(), input.end(), 0);
+    std::atomic<size_t> calls{0};
+
+    auto failed = parallel_try_for_each(
+        input,
+        [&](int i) -> result<void, int> {
+            ++calls;
+            if (i % 1000 == 999) {
+                return result<void, int>(in_place_error, i);
+            }
+            return result<void, int>(std::in_place);
+        },
+        {.threads = 4, .chunk_size = 8, .order = first_error::by_time});
+    REQUIRE(!failed.has_value());
+    REQUIRE(failed.error() % 1000 == 999);
+    REQUIRE(calls < input.size());
+}
+
+TEST_CASE("parallel exceptions", "[parallel]") {
+    std::vector<int> input(1000);
+    std::iota(input.begin(), input.end(), 0);
+    auto run = [&] {
+        return parallel_try_for_each(
+            input,
+            [](int i) -> result<void, int> {
+                if (i == 500) { throw std::runtime_error("boom"); }
+                return result<void, int>(std::in_place);
+            },
+            {.threads = 4});
+    };
+    REQUIRE_THROWS_AS(run(), std::runtime_error);
+}
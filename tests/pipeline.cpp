@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/pipeline.hpp>
+
+#include <ranges>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+result<int, std::string> parse(const std::string& s) {
+    if (s.empty() || s.find_first_not_of("0123456789") != std::string::npos) {
+        return error<std::string>("not a number: " + s);
+    }
+    return std::stoi(s);
+}
+
+result<int, std::string> check_port(int port) {
+    if (port == 0 || port > 65535) {
+        return error<std::string>("out of range");
+    }
+    return port;
+}
+
+} // namespace
+
+TEST_CASE("pipeline result", "[pipeline]") {
+    int calls = 0;
+    auto validate = then(parse) | map([&](int x) {
+                        ++calls;
+                        return x * 10;
+                    }) |
+                    then(check_port);
+
+    using input = result<std::string, std::string>;
+    auto ok = input("80") | validate;
+    STATIC_REQUIRE(std::is_same_v<decltype(ok), result<int, std::string>>);
+    REQUIRE(ok == 800);
+
+    REQUIRE((input("9000") | validate).error() == "out of range");
+    REQUIRE((input("x1") | validate).error() ==
+            "not a number: x1");
+    REQUIRE(calls == 2);
+
+    auto with_default =
+        validate |
+        jac::or_else([](const std::string&) -> result<int, std::string> {
+            return 8080;
+        }) |
+        map([](int x) { return std::to_string(x); });
+
+    REQUIRE(*(input("abc") | with_default) == "8080");
+    REQUIRE(*(input("5") | with_default) == "50");
+
+    // Errors skip every step up to the next or_else
+    result<int, std::string> failed(in_place_error, "early");
+    auto steps = map([](int) -> int { throw 1; }) |
+                 jac::or_else([](std::string e) {
+                     return result<int, std::string>(in_place_error, e + "!");
+                 });
+    REQUIRE((failed | steps).error() == "early!");
+}
+
+TEST_CASE("pipeline option", "[pipeline]") {
+    auto half = [](int x) -> option<int> {
+        if (x % 2 != 0) { return null; }
+        return x / 2;
+    };
+    auto p = then(half) | then(half) | map([](int x) { return x + 1; });
+
+    REQUIRE(*(option<int>(12) | p) == 4);
+    REQUIRE(!(option<int>(6) | p).has_value());
+    REQUIRE(!(option<int>() | p).has_value());
+
+    auto fallback = p | jac::or_else([] { return option<int>(-1); });
+    REQUIRE(*fallback(option<int>(6)) == -1);
+
+    int value = 3;
+    option<int&> ref(value);
+    auto inc = map([](int& x) -> int& { return ++x; });
+    auto out = ref | inc;
+    STATIC_REQUIRE(std::is_same_v<decltype(out), option<int&>>);
+    REQUIRE(&*out == &value);
+    REQUIRE(value == 4);
+
+    auto ignore = map([](int) {});
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(option<int>(1) | ignore), option<void>>);
+    REQUIRE((option<int>(1) | ignore).has_value());
+}
+
+TEST_CASE("pipeline ranges", "[pipeline]") {
+    std::vector<result<std::string, std::string>> fields{"1", "x", "70000",
+                                                         "443"};
+    auto validate = then(parse) | then(check_port);
+
+    std::vector<bool> valid;
+    for (auto r : fields | std::views::transform(validate)) {
+        valid.push_back(r.has_value());
+    }
+    REQUIRE(valid == std::vector<bool>{true, false, false, true});
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/poly.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+struct shape {
+    static inline int live = 0;
+
+    shape() { ++live; }
+    shape(const shape&) noexcept { ++live; }
+    virtual ~shape() { --live; }
+
+    virtual double area() const = 0;
+    virtual std::string name() const = 0;
+};
+
+struct square : shape {
+    double side;
+
+    explicit square(double s) : side(s) {}
+
+    double area() const override { return side * side; }
+    std::string name() const override { return "square"; }
+};
+
+struct labeled : shape {
+    std::string label;
+
+    explicit labeled(std::string l) : label(std::move(l)) {}
+
+    double area() const override { return 0; }
+    std::string name() const override { return label; }
+};
+
+struct big : shape {
+    std::array<double, 16> data{};
+
+    double area() const override { return data[0]; }
+    std::string name() const override { return "big"; }
+};
+
+struct mixin {
+    virtual ~mixin() = default;
+    int tag = 7;
+};
+
+// The shape subobject is not at the start of the object
+struct offset_square : mixin, square {
+    using trivially_relocatable = std::true_type;
+
+    explicit offset_square(double s) : square(s) {}
+};
+
+} // namespace
+
+TEST_CASE("poly basics", "[poly]") {
+    STATIC_REQUIRE(poly<shape>::is_inline_type<square>);
+    STATIC_REQUIRE(!poly<shape>::is_inline_type<big>);
+
+    poly<shape> empty;
+    REQUIRE(!empty);
+    REQUIRE(empty.get() == nullptr);
+
+    poly<shape> s = square(2);
+    REQUIRE(s.is_inline());
+    REQUIRE(s->area() == 4);
+
+    poly<shape> b{std::in_place_type<big>};
+    REQUIRE(!b.is_inline());
+    REQUIRE(b->name() == "big");
+
+    poly<shape> l(labeled("a fairly long label that allocates"));
+    REQUIRE(l->name() == "a fairly long label that allocates");
+
+    // Copies are deep
+    auto copy = l;
+    static_cast<labeled&>(*copy).label = "changed";
+    REQUIRE(l->name() == "a fairly long label that allocates");
+    REQUIRE(copy->name() == "changed");
+
+    auto moved = std::move(copy);
+    REQUIRE(!copy);
+    REQUIRE(moved->name() == "changed");
+
+    swap(s, b);
+    REQUIRE(s->name() == "big");
+    REQUIRE(b->area() == 4);
+
+    b.emplace<labeled>("x");
+    REQUIRE(b->name() == "x");
+    b = null;
+    REQUIRE(!b);
+}
+
+TEST_CASE("poly lifetime", "[poly]") {
+    REQUIRE(shape::live == 0);
+    {
+        std::vector<poly<shape>> shapes;
+        for (int i = 0; i < 50; ++i) {
+            switch (i % 4) {
+            case 0: shapes.emplace_back(square(i)); break;
+            case 1: shapes.emplace_back(labeled(std::string(i, 'x'))); break;
+            case 2: shapes.emplace_back(std::in_place_type<big>); break;
+            default: shapes.emplace_back(offset_square(i)); break;
+            }
+        }
+        REQUIRE(shape::live == 50);
+
+        auto copies = shapes;
+        REQUIRE(shape::live == 100);
+        shapes.erase(shapes.begin(), shapes.begin() + 10);
+        REQUIRE(shape::live == 90);
+
+        for (size_t i = 0; i < copies.size(); ++i) {
+            switch (i % 4) {
+            case 0: REQUIRE(copies[i]->area() == double(i * i)); break;
+            case 1: REQUIRE(copies[i]->name() == std::string(i, 'x')); break;
+            case 2: REQUIRE(copies[i]->name() == "big"); break;
+            default:
+                REQUIRE(copies[i]->area() == double(i * i));
+                REQUIRE(dynamic_cast<mixin&>(*copies[i]).tag == 7);
+                break;
+            }
+        }
+    }
+    REQUIRE(shape::live == 0);
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/option.hpp>
+#include <jac/relocate.hpp>
+#include <jac/result.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace jac;
+
+namespace {
+
+struct opted_in {
+    using trivially_relocatable = std::true_type;
+
+    std::unique_ptr<int> ptr;
+};
+
+struct not_relocatable {
+    not_relocatable() = default;
+    not_relocatable(not_relocatable&&) noexcept {}
+    ~not_relocatable() {}
+};
+
+} // namespace
+
+TEST_CASE("is_trivially_relocatable", "[relocate]") {
+    REQUIRE(is_trivially_relocatable_v<int>);
+    REQUIRE(is_trivially_relocatable_v<int[4]>);
+    REQUIRE(is_trivially_relocatable_v<opted_in>);
+    REQUIRE(!is_trivially_relocatable_v<not_relocatable>);
+    REQUIRE(is_trivially_relocatable_v<std::unique_ptr<int>>);
+    REQUIRE(is_trivially_relocatable_v<std::unique_ptr<not_relocatable[]>>);
+    REQUIRE(!is_trivially_relocatable_v<
+            std::unique_ptr<int, void (*)(int*)>>);
+
+    REQUIRE(is_trivially_relocatable_v<holder<int>>);
+    REQUIRE(is_trivially_relocatable_v<holder<not_relocatable&>>);
+    REQUIRE(is_trivially_relocatable_v<holder<void>>);
+    REQUIRE(is_trivially_relocatable_v<holder<opted_in>>);
+    REQUIRE(!is_trivially_relocatable_v<holder<not_relocatable>>);
+
+    REQUIRE(is_trivially_relocatable_v<option<opted_in>>);
+    REQUIRE(is_trivially_relocatable_v<option<not_relocatable&>>);
+    REQUIRE(!is_trivially_relocatable_v<option<not_relocatable>>);
+
+    REQUIRE(is_trivially_relocatable_v<result<opted_in, int>>);
+    REQUIRE(is_trivially_relocatable_v<result<void, int&>>);
+    REQUIRE(!is_trivially_relocatable_v<result<int, not_relocatable>>);
+}
+
+TEST_CASE("relocate unique_ptr", "[relocate]") {
+    std::allocator<std::unique_ptr<int>> alloc;
+    auto src = alloc.allocate(2);
+    auto dst = alloc.allocate(2);
+    std::construct_at(src + 0, std::make_unique<int>(1));
+    std::construct_at(src + 1, std::make_unique<int>(2));
+
+    REQUIRE(uninitialized_relocate_n(src, 2, dst) == dst + 2);
+    REQUIRE(*dst[0] == 1);
+    REQUIRE(*dst[1] == 2);
+
+    std::destroy_n(dst, 2);
+    alloc.deallocate(src, 2);
+    alloc.deallocate(dst, 2);
+}
+
+TEST_CASE("uninitialized_relocate_n", "[relocate]") {
+    std::allocator<std::string> alloc;
+    auto src = alloc.allocate(3);
+    auto dst = alloc.allocate(3);
+    std::construct_at(src + 0, "one");
+    std::construct_at(src + 1, "two");
+    std::construct_at(src + 2, "a string long enough to not be inlined");
+
+    REQUIRE(uninitialized_relocate_n(src, 3, dst) == dst + 3);
+    REQUIRE(dst[0] == "one");
+    REQUIRE(dst[1] == "two");
+    REQUIRE(dst[2] == "a string long enough to not be inlined");
+
+    std::destroy_at(dst + 2);
+    REQUIRE(uninitialized_relocate_backward(dst, dst + 2, dst + 3) == dst + 1);
+    std::construct_at(dst, "zero");
+    REQUIRE(dst[0] == "zero");
+    REQUIRE(dst[1] == "one");
+    REQUIRE(dst[2] == "two");
+
+    std::destroy_n(dst, 3);
+    alloc.deallocate(src, 3);
+    alloc.deallocate(dst, 3);
+}
+
+TEST_CASE("relocate opted in", "[relocate]") {
+    std::allocator<opted_in> alloc;
+    auto src = alloc.allocate(1);
+    auto dst = alloc.allocate(1);
+    std::construct_at(src, opted_in{std::make_unique<int>(42)});
+
+    auto obj = relocate(src, dst);
+    REQUIRE(*obj->ptr == 42);
+
+    std::destroy_at(obj);
+    alloc.deallocate(src, 1);
+    alloc.deallocate(dst, 1);
+}
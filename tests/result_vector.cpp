@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/result_vector.hpp>
+
+#include <stdexcept>
+#include <string>
+
+using namespace jac;
+
+namespace {
+
+struct fragile {
+    int value;
+
+    explicit fragile(int v) : value(v) {}
+
+    fragile(const fragile& other) : value(other.value) {
+        if (value < 0) { throw std::runtime_error("fragile"); }
+    }
+
+    fragile& operator=(const fragile&) = default;
+};
+
+} // namespace
+
+TEST_CASE("result_vector push", "[result_vector]") {
+    result_vector<std::string, int> vec;
+    for (int i = 0; i < 200; ++i) {
+        if (i % 50 == 7) {
+            vec.push_back(result<std::string, int>(make_error<int>(i)));
+        } else {
+            vec.push_back(result<std::string, int>(std::to_string(i)));
+        }
+    }
+
+    REQUIRE(vec.size() == 200);
+    REQUIRE(vec.error_count() == 4);
+    REQUIRE(vec.value_count() == 196);
+
+    for (size_t i = 0; i < vec.size(); ++i) {
+        auto res = vec[i];
+        if (i % 50 == 7) {
+            REQUIRE(!vec.has_value(i));
+            REQUIRE(!res.has_value());
+            REQUIRE(res.error() == static_cast<int>(i));
+        } else {
+            REQUIRE(vec.has_value(i));
+            REQUIRE(res.has_value());
+            REQUIRE(*res == std::to_string(i));
+        }
+    }
+
+    auto copy = vec;
+    REQUIRE(copy.size() == vec.size());
+    REQUIRE(copy.values()[0] == "0");
+    REQUIRE(copy.values()[195] == "199");
+    REQUIRE(copy.errors()[3].index == 157);
+}
+
+TEST_CASE("result_vector columns", "[result_vector]") {
+    result_vector<int, std::string> vec;
+    vec.emplace_back(1);
+    vec.emplace_back_error("bad");
+    vec.emplace_back(2);
+    vec.emplace_back(3);
+    vec.emplace_back_error("worse");
+
+    auto values = vec.values();
+    REQUIRE(values.size() == 3);
+    REQUIRE(values[0] == 1);
+    REQUIRE(values[1] == 2);
+    REQUIRE(values[2] == 3);
+
+    auto errors = vec.errors();
+    REQUIRE(errors.size() == 2);
+    REQUIRE(errors[0].index == 1);
+    REQUIRE(errors[0].error == "bad");
+    REQUIRE(errors[1].index == 4);
+    REQUIRE(errors[1].error == "worse");
+
+    *vec[3] = 42;
+    REQUIRE(vec.values()[2] == 42);
+
+    vec.clear();
+    REQUIRE(vec.empty());
+    REQUIRE(vec.values().empty());
+    REQUIRE(vec.errors().empty());
+}
+
+TEST_CASE("result_vector copy throws", "[result_vector]") {
+    result_vector<fragile, int> vec;
+    vec.emplace_back(1);
+    vec.emplace_back_error(2);
+    vec.emplace_back(-1);
+
+    REQUIRE_THROWS_AS((result_vector<fragile, int>(vec)), std::runtime_error);
+
+    result_vector<fragile, int> other;
+    other.emplace_back(5);
+    REQUIRE_THROWS_AS(other = vec, std::runtime_error);
+    REQUIRE(other.size() == 1);
+    REQUIRE(other.values()[0].value == 5);
+}
@@ -0,0 +1,126 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/ring_buffer.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+using namespace jac;
+
+namespace {
+
+struct counted {
+    static inline int live = 0;
+    static inline int copies_left = 0;
+
+    counted() { ++live; }
+
+    counted([[maybe_unused]] const counted& other) {
+        if (copies_left-- == 0) { throw std::runtime_error("copy failed"); }
+        ++live;
+    }
+
+    ~counted() { --live; }
+};
+
+} // namespace
+
+TEST_CASE("ring_buffer reject when full", "[ring_buffer]") {
+    ring_buffer<std::string, 4> buf;
+    REQUIRE(buf.capacity() == 4);
+    REQUIRE(buf.try_push_back("a").has_value());
+    REQUIRE(buf.try_push_back("b").has_value());
+    REQUIRE(buf.try_push_front("z").has_value());
+    REQUIRE(buf.try_emplace_back(3, 'c').has_value());
+    REQUIRE(buf.full());
+    REQUIRE(!buf.try_push_back("d").has_value());
+    REQUIRE(!buf.try_push_front("y").has_value());
+
+    REQUIRE(*buf.front() == "z");
+    REQUIRE(*buf.back() == "ccc");
+    REQUIRE(*buf.pop_front() == "z");
+    REQUIRE(*buf.pop_back() == "ccc");
+    REQUIRE(*buf.pop_front() == "a");
+    REQUIRE(*buf.pop_front() == "b");
+    REQUIRE(!buf.pop_front().has_value());
+    REQUIRE(!buf.pop_back().has_value());
+    REQUIRE(!buf.front().has_value());
+}
+
+TEST_CASE("ring_buffer overwrite oldest", "[ring_buffer]") {
+    ring_buffer<int> buf(5);
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE(!buf.push_back_overwrite(i).has_value());
+    }
+    for (int i = 5; i < 13; ++i) {
+        REQUIRE(*buf.push_back_overwrite(i) == i - 5);
+    }
+    REQUIRE(buf.size() == 5);
+    for (size_t i = 0; i < buf.size(); ++i) {
+        REQUIRE(buf[i] == static_cast<int>(i) + 8);
+    }
+
+    REQUIRE(*buf.push_front_overwrite(7) == 12);
+    REQUIRE(*buf.front() == 7);
+    REQUIRE(*buf.back() == 11);
+}
+
+TEST_CASE("ring_buffer spans", "[ring_buffer]") {
+    ring_buffer<int, 8> buf;
+    for (int i = 0; i < 6; ++i) { buf.try_push_back(i); }
+
+    auto [first, second] = buf.as_spans();
+    REQUIRE(first.size() == 6);
+    REQUIRE(second.empty());
+
+    for (int i = 6; i < 12; ++i) { buf.push_back_overwrite(i); }
+    auto [head, tail] = buf.as_spans();
+    REQUIRE(head.size() + tail.size() == 8);
+    REQUIRE(!tail.empty());
+    int expected = 4;
+    for (auto value : head) { REQUIRE(value == expected++); }
+    for (auto value : tail) { REQUIRE(value == expected++); }
+
+    REQUIRE(std::accumulate(buf.begin(), buf.end(), 0) ==
+            4 + 5 + 6 + 7 + 8 + 9 + 10 + 11);
+}
+
+TEST_CASE("ring_buffer copy and move", "[ring_buffer]") {
+    ring_buffer<std::string, 3> fixed;
+    ring_buffer<std::string> dynamic(3);
+    for (int i = 0; i < 5; ++i) {
+        fixed.push_back_overwrite(std::to_string(i));
+        dynamic.push_back_overwrite(std::to_string(i));
+    }
+
+    auto fixed_copy = fixed;
+    auto dynamic_copy = dynamic;
+    auto fixed_moved = std::move(fixed);
+    auto dynamic_moved = std::move(dynamic);
+    REQUIRE(fixed.empty());
+    REQUIRE(dynamic.empty());
+
+    for (size_t i = 0; i < 3; ++i) {
+        auto expected = std::to_string(i + 2);
+        REQUIRE(fixed_copy[i] == expected);
+        REQUIRE(dynamic_copy[i] == expected);
+        REQUIRE(fixed_moved[i] == expected);
+        REQUIRE(dynamic_moved[i] == expected);
+    }
+
+    fixed = fixed_copy;
+    dynamic = std::move(dynamic_copy);
+    REQUIRE(*fixed.front() == "2");
+    REQUIRE(*dynamic.back() == "4");
+}
+
+TEST_CASE("ring_buffer copy throws", "[ring_buffer]") {
+    {
+        ring_buffer<counted, 4> buf;
+        for (int i = 0; i < 4; ++i) { buf.try_emplace_back(); }
+        counted::copies_left = 2;
+        REQUIRE_THROWS_AS((ring_buffer<counted, 4>(buf)), std::runtime_error);
+        REQUIRE(counted::live == 4);
+    }
+    REQUIRE(counted::live == 0);
+}
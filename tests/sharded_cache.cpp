@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/clock_cache.hpp>
+#include <jac/lru_cache.hpp>
+#include <jac/sharded_cache.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+// Has no default constructor, so the shards' hasher must be used for routing
+struct seeded_int_hash {
+    uint64_t seed;
+
+    explicit seeded_int_hash(uint64_t s) : seed(s) {}
+
+    size_t operator()(int key) const noexcept {
+        return static_cast<size_t>(hash_mix(uint64_t(key) ^ seed));
+    }
+};
+
+} // namespace
+
+TEST_CASE("sharded_cache basics", "[sharded_cache]") {
+    REQUIRE_THROWS_AS((sharded_cache<lru_cache<int, int>>(0, size_t(4))),
+                      std::invalid_argument);
+
+    sharded_cache<lru_cache<int, std::string>> cache(4, size_t(100));
+    REQUIRE(cache.shard_count() == 4);
+    for (int i = 0; i < 100; ++i) { cache.put(i, std::to_string(i)); }
+    REQUIRE(cache.size() == 100);
+    REQUIRE(*cache.get(42) == "42");
+    REQUIRE(!cache.get(1000).has_value());
+
+    REQUIRE(cache.visit(7, [](std::string& value) { value += "!"; }));
+    REQUIRE(!cache.visit(1000, [](std::string&) {}));
+    REQUIRE(*cache.get(7) == "7!");
+
+    auto r = cache.try_get_or_insert(
+        500, []() -> result<std::string, int> { return std::string("x"); });
+    REQUIRE(*r == "x");
+    REQUIRE(cache.contains(500));
+    auto err = cache.try_get_or_insert(
+        501, []() -> result<std::string, int> { return error<int>(1); });
+    REQUIRE(err.error() == 1);
+
+    REQUIRE(*cache.erase(42) == "42");
+    REQUIRE(!cache.contains(42));
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("sharded_cache threads", "[sharded_cache]") {
+    sharded_cache<clock_cache<int, int>> cache(8, size_t(1000));
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, &mismatches, t] {
+            for (int i = 0; i < 2000; ++i) {
+                int key = (i * 7 + t) % 4000;
+                cache.put(key, key * 2);
+                auto value = cache.get(key ^ 1);
+                if (value && *value != (key ^ 1) * 2) { ++mismatches; }
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    REQUIRE(mismatches == 0);
+    REQUIRE(cache.size() <= 8000);
+    REQUIRE(cache.size() > 0);
+}
+
+TEST_CASE("sharded_cache stateful hasher", "[sharded_cache]") {
+    sharded_cache<clock_cache<int, int, seeded_int_hash>> clock(
+        4, size_t(100), seeded_int_hash(7));
+    sharded_cache<lru_cache<int, int, seeded_int_hash>> lru(
+        4, size_t(100), unit_cost(), seeded_int_hash(9));
+    for (int i = 0; i < 50; ++i) {
+        clock.put(i, i);
+        lru.put(i, i);
+    }
+    for (int i = 0; i < 50; ++i) {
+        REQUIRE(*clock.get(i) == i);
+        REQUIRE(*lru.get(i) == i);
+    }
+    REQUIRE(clock.size() == 50);
+    REQUIRE(lru.size() == 50);
+
+    lru_cache<int, int, seeded_int_hash> single(4, unit_cost(),
+                                                seeded_int_hash(3));
+    REQUIRE(single.hash_function().seed == 3);
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/static_map.hpp>
+
+#include <set>
+#include <string>
+#include <string_view>
+
+using namespace jac;
+
+namespace {
+
+enum class token { if_kw, else_kw, while_kw, for_kw, return_kw, break_kw };
+
+constexpr auto keywords = make_static_map<std::string_view, token>({
+    {"if", token::if_kw},
+    {"else", token::else_kw},
+    {"while", token::while_kw},
+    {"for", token::for_kw},
+    {"return", token::return_kw},
+    {"break", token::break_kw},
+});
+
+static_assert(*keywords.find("while") == token::while_kw);
+static_assert(!keywords.contains("continue"));
+
+} // namespace
+
+TEST_CASE("static_map string keys", "[static_map]") {
+    REQUIRE(keywords.size() == 6);
+    REQUIRE(*keywords.find("if") == token::if_kw);
+    REQUIRE(*keywords.find("else") == token::else_kw);
+    REQUIRE(*keywords.find("for") == token::for_kw);
+    REQUIRE(*keywords.find("return") == token::return_kw);
+    REQUIRE(*keywords.find("break") == token::break_kw);
+    REQUIRE(!keywords.find("").has_value());
+    REQUIRE(!keywords.find("iff").has_value());
+
+    std::string dynamic = "while";
+    REQUIRE(*keywords.find(dynamic) == token::while_kw);
+
+    size_t count = 0;
+    for (auto& [key, value] : keywords) {
+        REQUIRE(*keywords.find(key) == value);
+        ++count;
+    }
+    REQUIRE(count == 6);
+}
+
+TEST_CASE("static_map integer keys", "[static_map]") {
+    static constexpr auto codes = make_static_map<int, std::string_view>({
+        {200, "OK"},
+        {201, "Created"},
+        {204, "No Content"},
+        {301, "Moved Permanently"},
+        {304, "Not Modified"},
+        {400, "Bad Request"},
+        {401, "Unauthorized"},
+        {403, "Forbidden"},
+        {404, "Not Found"},
+        {500, "Internal Server Error"},
+        {502, "Bad Gateway"},
+        {503, "Service Unavailable"},
+    });
+
+    REQUIRE(*codes.find(404) == "Not Found");
+    REQUIRE(*codes.find(200) == "OK");
+    REQUIRE(*codes.find(503) == "Service Unavailable");
+    REQUIRE(!codes.find(418).has_value());
+    std::set<int> listed{200, 201, 204, 301, 304, 400,
+                         401, 403, 404, 500, 502, 503};
+    for (int code = 0; code < 1000; ++code) {
+        bool expected = listed.contains(code);
+        REQUIRE(codes.find(code).has_value() == expected);
+        REQUIRE(codes.contains(code) == expected);
+    }
+}
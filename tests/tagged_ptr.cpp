@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/option.hpp>
+#include <jac/result.hpp>
+#include <jac/tagged_ptr.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+using namespace jac;
+
+namespace {
+
+enum class lookup_error : uint8_t { missing, expired, forbidden = 200 };
+
+enum class bool_error : bool { no, yes };
+
+struct node {
+    int64_t value;
+};
+
+} // namespace
+
+TEST_CASE("tagged_ptr basics", "[tagged_ptr]") {
+    STATIC_REQUIRE(sizeof(tagged_ptr<node, 3>) == sizeof(node*));
+    STATIC_REQUIRE(tagged_ptr<node, 3>::max_tag == 7);
+
+    node a{1};
+    node b{2};
+    tagged_ptr<node, 3> p(&a, 5);
+    REQUIRE(p.get() == &a);
+    REQUIRE(p.tag() == 5);
+    REQUIRE(p->value == 1);
+
+    p.set(&b);
+    REQUIRE(p.get() == &b);
+    REQUIRE(p.tag() == 5);
+
+    p.set_tag(2);
+    REQUIRE((*p).value == 2);
+    REQUIRE(p.tag() == 2);
+    REQUIRE(p == tagged_ptr<node, 3>(&b, 2));
+    REQUIRE(p != tagged_ptr<node, 3>(&b, 3));
+
+    REQUIRE_THROWS_AS(p.set_tag(8), std::invalid_argument);
+
+    tagged_ptr<node, 3> null;
+    REQUIRE(!null);
+    null.set_tag(7);
+    REQUIRE(!null);
+    REQUIRE(null.get() == nullptr);
+}
+
+#if JAC_POINTER_HIGH_BITS >= 8
+TEST_CASE("tagged_ptr high bits", "[tagged_ptr]") {
+    std::string s = "x";
+    tagged_ptr<std::string, 10> p(&s, 0x3a5);
+    REQUIRE(p.tag() == 0x3a5);
+    REQUIRE(*p == "x");
+    p.set_tag(tagged_ptr<std::string, 10>::max_tag);
+    REQUIRE(p.get() == &s);
+    REQUIRE(p.tag() == 1023);
+
+    char c = 'c';
+    REQUIRE_THROWS_AS((tagged_ptr<char, 1>(&c + 0, 2)), std::invalid_argument);
+}
+
+TEST_CASE("tagged_ptr packed result", "[tagged_ptr]") {
+    STATIC_REQUIRE(sizeof(result<node&, lookup_error>) == sizeof(void*));
+    STATIC_REQUIRE(sizeof(result<const node&, int8_t>) == sizeof(void*));
+    STATIC_REQUIRE(sizeof(option<node&>) == sizeof(void*));
+    STATIC_REQUIRE(sizeof(result<node&, int64_t>) > sizeof(void*));
+    STATIC_REQUIRE(sizeof(result<node&, uint16_t>) > sizeof(void*));
+    STATIC_REQUIRE(sizeof(result<node&, bool_error>) > sizeof(void*));
+
+    node n{7};
+    result<node&, lookup_error> found = n;
+    REQUIRE(found.has_value());
+    REQUIRE(&*found == &n);
+    REQUIRE(found->value == 7);
+    found.value().value = 8;
+    REQUIRE(n.value == 8);
+
+    result<node&, lookup_error> err = error<lookup_error>(
+        lookup_error::forbidden);
+    REQUIRE(!err.has_value());
+    REQUIRE(err.error() == lookup_error::forbidden);
+    REQUIRE_THROWS_AS(err.value(), bad_result_access);
+    REQUIRE(err.error_or(lookup_error::missing) == lookup_error::forbidden);
+
+    auto mapped = found.transform([](node& x) { return x.value * 2; });
+    REQUIRE(*mapped == 16);
+
+    swap(found, err);
+    REQUIRE(found.error() == lookup_error::forbidden);
+    REQUIRE(err->value == 8);
+
+    found = err;
+    REQUIRE(&*found == &n);
+    found.emplace_error(lookup_error::expired);
+    REQUIRE(found == error<lookup_error>(lookup_error::expired));
+
+    result<const node&, int8_t> negative(in_place_error, int8_t(-3));
+    REQUIRE(negative.error() == -3);
+}
+#endif
@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/timer_wheel.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jac;
+
+TEST_CASE("timer_wheel basics", "[timer_wheel]") {
+    timer_wheel<std::string> wheel(100);
+    REQUIRE(wheel.now() == 100);
+    auto a = wheel.schedule(105, "a");
+    auto b = wheel.schedule(170, "b");
+    auto c = wheel.schedule(1'000'000, "c");
+    auto late = wheel.schedule(50, "late");
+    REQUIRE(wheel.size() == 4);
+    REQUIRE(*wheel.get(b) == "b");
+    REQUIRE(*wheel.deadline(c) == 1'000'000);
+
+    std::vector<std::string> fired;
+    auto collect = [&](std::string&& s) { fired.push_back(std::move(s)); };
+
+    REQUIRE(wheel.advance(104, collect) == 1);
+    REQUIRE(fired == std::vector<std::string>{"late"});
+    REQUIRE(!wheel.contains(late));
+    REQUIRE(wheel.now() == 104);
+
+    REQUIRE(wheel.advance(105, collect) == 1);
+    REQUIRE(fired.back() == "a");
+    REQUIRE(!wheel.contains(a));
+    REQUIRE(!wheel.cancel(a).has_value());
+
+    REQUIRE(wheel.advance(169, collect) == 0);
+    REQUIRE(*wheel.cancel(b) == "b");
+    REQUIRE(!wheel.contains(b));
+    REQUIRE(wheel.advance(999'999, collect) == 0);
+    REQUIRE(wheel.advance(1'000'000, collect) == 1);
+    REQUIRE(fired.back() == "c");
+    REQUIRE(wheel.empty());
+    REQUIRE(wheel.now() == 1'000'000);
+
+    // Storage is reused, but old handles stay dead
+    auto d = wheel.schedule(2'000'000, "d");
+    REQUIRE(wheel.contains(d));
+    REQUIRE(!wheel.contains(c));
+    REQUIRE(!wheel.contains(timer_wheel<std::string>::handle()));
+    wheel.clear();
+    REQUIRE(!wheel.contains(d));
+    REQUIRE(wheel.empty());
+}
+
+TEST_CASE("timer_wheel reschedule", "[timer_wheel]") {
+    timer_wheel<int> wheel;
+    auto h = wheel.schedule(10, 1);
+    REQUIRE(wheel.reschedule(h, 5000));
+    std::vector<int> fired;
+    auto collect = [&](int v) { fired.push_back(v); };
+    REQUIRE(wheel.advance(4999, collect) == 0);
+    REQUIRE(wheel.reschedule(h, 4000));
+    REQUIRE(wheel.advance(5000, collect) == 1);
+    REQUIRE(fired == std::vector<int>{1});
+    REQUIRE(!wheel.reschedule(h, 6000));
+}
+
+TEST_CASE("timer_wheel schedule from callback", "[timer_wheel]") {
+    timer_wheel<std::unique_ptr<int>> wheel;
+    wheel.schedule(10, std::make_unique<int>(3));
+    int fired = 0;
+    wheel.advance(100, [&](std::unique_ptr<int> p) {
+        ++fired;
+        if (*p > 0) {
+            wheel.schedule(wheel.now() + 10, std::make_unique<int>(*p - 1));
+        }
+    });
+    // Fired at 10, 20, 30 and 40
+    REQUIRE(fired == 4);
+    REQUIRE(wheel.empty());
+}
+
+TEST_CASE("timer_wheel random", "[timer_wheel]") {
+    std::mt19937_64 rng(3);
+    timer_wheel<uint64_t> wheel;
+    std::multimap<uint64_t, uint64_t> model;
+    std::map<uint64_t, timer_wheel<uint64_t>::handle> handles;
+    uint64_t now = 0;
+    uint64_t id = 0;
+
+    for (int round = 0; round < 2000; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            // Mix short, medium and very long delays
+            auto delay = rng() >> (rng() % 64);
+            auto deadline = delay > UINT64_MAX - now ? UINT64_MAX : now + delay;
+            handles[id] = wheel.schedule(deadline, id);
+            model.emplace(deadline, id);
+            ++id;
+        }
+        if (!handles.empty() && rng() % 2 == 0) {
+            auto it = handles.lower_bound(rng() % id);
+            if (it != handles.end()) {
+                auto deadline = *wheel.deadline(it->second);
+                REQUIRE(*wheel.cancel(it->second) == it->first);
+                auto [first, last] = model.equal_range(deadline);
+                for (; first != last; ++first) {
+                    if (first->second == it->first) {
+                        model.erase(first);
+                        break;
+                    }
+                }
+                handles.erase(it);
+            }
+        }
+
+        now += rng() % 5000;
+        std::vector<uint64_t> fired;
+        wheel.advance(now, [&](uint64_t v) {
+            REQUIRE(!wheel.contains(handles[v]));
+            fired.push_back(v);
+            handles.erase(v);
+        });
+        std::vector<uint64_t> expected;
+        while (!model.empty() && model.begin()->first <= now) {
+            expected.push_back(model.begin()->second);
+            model.erase(model.begin());
+        }
+        std::sort(fired.begin(), fired.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(fired == expected);
+        REQUIRE(wheel.size() == model.size());
+    }
+}
@@ -0,0 +1,204 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/variant.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+template <typename... Fs>
+struct overloaded : Fs... {
+    using Fs::operator()...;
+};
+
+template <typename... Fs>
+overloaded(Fs...) -> overloaded<Fs...>;
+
+struct throws_on_copy {
+    int value = 0;
+
+    throws_on_copy() = default;
+    explicit throws_on_copy(int v) : value(v) {}
+    throws_on_copy(const throws_on_copy&) { throw std::runtime_error("copy"); }
+    throws_on_copy(throws_on_copy&&) noexcept = default;
+    throws_on_copy& operator=(const throws_on_copy&) = default;
+    throws_on_copy& operator=(throws_on_copy&&) noexcept = default;
+};
+
+template <size_t I>
+struct tag {
+    int value = I;
+};
+
+template <size_t... Is>
+auto make_big(std::index_sequence<Is...>) -> variant<tag<Is>...>;
+
+using big_variant = decltype(make_big(std::make_index_sequence<40>{}));
+
+} // namespace
+
+TEST_CASE("variant basics", "[variant]") {
+    STATIC_REQUIRE(sizeof(variant<int, char>) == 2 * sizeof(int));
+    STATIC_REQUIRE(sizeof(variant<char, bool>) == 2);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<variant<int, double>>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<variant<int, std::string*>>);
+
+    variant<int, std::string> v;
+    REQUIRE(v.index() == 0);
+    REQUIRE(get<0>(v) == 0);
+
+    v = "hello";
+    REQUIRE(v.index() == 1);
+    REQUIRE(holds_alternative<std::string>(v));
+    REQUIRE(get<std::string>(v) == "hello");
+    REQUIRE(get_if<int>(&v) == nullptr);
+    REQUIRE(*get_if<1>(&v) == "hello");
+    REQUIRE_THROWS_AS(get<0>(v), bad_variant_access);
+
+    // Narrowing conversions and conversions to bool are not considered
+    variant<bool, std::string> text = "abc";
+    REQUIRE(text.index() == 1);
+    text = true;
+    REQUIRE(text.index() == 0);
+    STATIC_REQUIRE(!std::is_constructible_v<variant<char, std::string>, int>);
+    STATIC_REQUIRE(!std::is_assignable_v<variant<char, std::string>&, int>);
+    STATIC_REQUIRE(std::is_constructible_v<variant<char, long>, int>);
+    STATIC_REQUIRE(!std::is_constructible_v<variant<float, long>, double>);
+
+    auto copy = v;
+    REQUIRE(copy == v);
+    v = 5;
+    REQUIRE(get<0>(v) == 5);
+    REQUIRE(copy != v);
+
+    auto moved = std::move(copy);
+    REQUIRE(get<1>(moved) == "hello");
+
+    v.emplace<1>(3, 'x');
+    REQUIRE(get<1>(v) == "xxx");
+    swap(v, moved);
+    REQUIRE(get<1>(v) == "hello");
+    REQUIRE(get<1>(moved) == "xxx");
+    moved = 7;
+    swap(v, moved);
+    REQUIRE(get<0>(v) == 7);
+    REQUIRE(get<1>(moved) == "hello");
+
+    variant<std::vector<int>, int> list(std::in_place_index<0>, {1, 2, 3});
+    REQUIRE(get<0>(list).size() == 3);
+    list.emplace<0>({4, 5});
+    REQUIRE(get<0>(list) == std::vector<int>{4, 5});
+
+    REQUIRE(std::hash<variant<int, std::string>>{}(v) ==
+            std::hash<variant<int, std::string>>{}(v));
+}
+
+TEST_CASE("variant references and void", "[variant]") {
+    int x = 1;
+    int y = 2;
+    variant<int&, void, std::string> v(std::in_place_index<0>, x);
+    get<0>(v) = 10;
+    REQUIRE(x == 10);
+    REQUIRE(get_if<0>(&v) == &x);
+
+    // Reference alternatives rebind rather than assign through
+    variant<int&, void, std::string> w(std::in_place_index<0>, y);
+    v = w;
+    get<0>(v) = 20;
+    REQUIRE(x == 10);
+    REQUIRE(y == 20);
+
+    int z = 3;
+    variant<int&, float> r(std::in_place_index<0>, x);
+    r = z;
+    REQUIRE(x == 10);
+    REQUIRE(get_if<0>(&r) == &z);
+
+    v.emplace<1>();
+    REQUIRE(v.index() == 1);
+    REQUIRE(get<1>(v) == void_v);
+
+    auto name = visit(overloaded{
+                          [](int&) { return std::string("ref"); },
+                          [](void_t) { return std::string("void"); },
+                          [](const std::string& s) { return s; },
+                      },
+                      v);
+    REQUIRE(name == "void");
+
+    int arr[3] = {1, 2, 3};
+    variant<int[3], int> a(std::in_place_index<0>, 1, 2, 3);
+    REQUIRE(get<0>(a)[2] == arr[2]);
+}
+
+TEST_CASE("variant visit", "[variant]") {
+    variant<int, double, std::string> a = 2;
+    variant<int, std::string> b = std::string("ab");
+
+    auto describe = overloaded{
+        [](int x) { return std::to_string(x); },
+        [](double) { return std::string("d"); },
+        [](const std::string& s) { return s; },
+    };
+    REQUIRE(visit(describe, a) == "2");
+    a = 1.5;
+    REQUIRE(visit(describe, a) == "d");
+
+    auto combine = [&](const auto& l, const auto& r) {
+        return describe(l) + describe(r);
+    };
+    REQUIRE(visit(combine, a, b) == "dab");
+    a = std::string("x");
+    b = 4;
+    REQUIRE(visit(combine, a, b) == "x4");
+
+    // Rvalues are moved out
+    variant<std::unique_ptr<int>, int> p(std::make_unique<int>(3));
+    auto taken = visit(
+        overloaded{
+            [](std::unique_ptr<int>&& ptr) { return std::move(ptr); },
+            [](int) { return std::unique_ptr<int>(); },
+        },
+        std::move(p));
+    REQUIRE(*taken == 3);
+
+    // Large variants dispatch across several switch statements
+    for (size_t i : {0, 5, 31, 32, 33, 39}) {
+        big_variant big;
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+            ((i == Is ? (big.emplace<Is>(), void()) : void()), ...);
+        }(std::make_index_sequence<40>{});
+        REQUIRE(big.index() == i);
+        REQUIRE(visit([](auto t) { return size_t(t.value); }, big) == i);
+    }
+    STATIC_REQUIRE(sizeof(big_variant) == 2 * sizeof(int));
+}
+
+TEST_CASE("variant exception safety", "[variant]") {
+    variant<int, throws_on_copy> v = 3;
+    throws_on_copy t(4);
+    REQUIRE_THROWS_AS(v = t, std::runtime_error);
+    // The old value survives a throwing copy
+    REQUIRE(!v.valueless_by_exception());
+    REQUIRE(get<0>(v) == 3);
+
+    v = throws_on_copy(5);
+    REQUIRE(get<1>(v).value == 5);
+}
+
+TEST_CASE("variant constexpr", "[variant]") {
+    constexpr auto value = [] {
+        variant<int, char> v = 'a';
+        v = 42;
+        return get<0>(v);
+    }();
+    STATIC_REQUIRE(value == 42);
+}
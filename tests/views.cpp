@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include <jac/views.hpp>
+
+#include <algorithm>
+#include <list>
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace jac;
+
+namespace {
+
+using parsed = result<int, std::string>;
+
+parsed parse(const std::string& s) {
+    if (s.empty() || s.find_first_not_of("0123456789") != std::string::npos) {
+        return error<std::string>(s);
+    }
+    return std::stoi(s);
+}
+
+} // namespace
+
+TEST_CASE("views values and errors", "[views]") {
+    std::vector<parsed> rs{1, error<std::string>("a"), 2,
+                           error<std::string>("b"), 3};
+
+    std::vector<int> values;
+    for (int& v : rs | views::values) {
+        values.push_back(v);
+        v *= 10;
+    }
+    REQUIRE(values == std::vector<int>{1, 2, 3});
+    REQUIRE(*rs[4] == 30);
+
+    auto errs = rs | views::errors;
+    STATIC_REQUIRE(std::ranges::bidirectional_range<decltype(errs)>);
+    REQUIRE(std::ranges::distance(errs) == 2);
+    REQUIRE(*std::ranges::begin(errs) == "a");
+    REQUIRE(*std::ranges::prev(std::ranges::end(errs)) == "b");
+
+    std::list<option<std::string>> opts{"x", null, "y", null};
+    auto joined = opts | views::values | std::views::take(2);
+    std::string all;
+    for (const auto& s : joined) { all += s; }
+    REQUIRE(all == "xy");
+
+    // Ranges of temporaries yield values instead of dangling references
+    std::vector<std::string> words{"1", "two", "3"};
+    auto ints = words | std::views::transform(parse) | views::values;
+    STATIC_REQUIRE(
+        std::is_same_v<std::ranges::range_reference_t<decltype(ints)>, int>);
+    REQUIRE(std::ranges::equal(ints, std::vector<int>{1, 3}));
+
+    std::vector<parsed> none{error<std::string>("x")};
+    REQUIRE(std::ranges::empty(none | views::values));
+}
+
+TEST_CASE("views non-common range", "[views]") {
+    std::vector<parsed> rs{1, error<std::string>("a"), 2, 3, -1, 4};
+    auto head = rs | std::views::take_while([](const parsed& r) {
+                    return !r.has_value() || *r >= 0;
+                });
+    STATIC_REQUIRE(!std::ranges::common_range<decltype(head)>);
+
+    auto values = head | views::values;
+    STATIC_REQUIRE(!std::ranges::common_range<decltype(values)>);
+    REQUIRE(std::ranges::equal(values, std::vector<int>{1, 2, 3}));
+    REQUIRE(std::ranges::distance(head | views::errors) == 1);
+
+    auto evens = std::views::iota(0) | std::views::transform([](int i) {
+                     return i % 2 == 0 ? option<int>(i) : option<int>(null);
+                 }) |
+                 views::values;
+    REQUIRE(std::ranges::equal(evens | std::views::take(3),
+                               std::vector<int>{0, 2, 4}));
+}
+
+TEST_CASE("views unwrap_or and partition_results", "[views]") {
+    std::vector<option<int>> opts{1, null, 3};
+    auto filled = opts | views::unwrap_or(0);
+    REQUIRE(std::ranges::equal(filled, std::vector<int>{1, 0, 3}));
+
+    std::vector<parsed> rs{4, error<std::string>("e"), 5};
+    REQUIRE(std::ranges::equal(rs | views::unwrap_or(-1),
+                               std::vector<int>{4, -1, 5}));
+
+    auto [good, bad] = rs | views::partition_results;
+    REQUIRE(std::ranges::equal(good, std::vector<int>{4, 5}));
+    REQUIRE(std::ranges::distance(bad) == 1);
+    REQUIRE(*bad.begin() == "e");
+}
+
+TEST_CASE("views option range", "[views]") {
+    STATIC_REQUIRE(std::ranges::contiguous_range<option<int>>);
+    STATIC_REQUIRE(std::ranges::sized_range<option<std::string>>);
+    STATIC_REQUIRE(std::ranges::borrowed_range<option<int&>>);
+
+    option<int> some(5);
+    int total = 0;
+    for (int x : some) { total += x; }
+    REQUIRE(total == 5);
+    REQUIRE(std::ranges::size(some) == 1);
+    REQUIRE(std::ranges::empty(option<int>()));
+
+    int value = 2;
+    option<int&> ref(value);
+    for (int& x : ref) { x = 9; }
+    REQUIRE(value == 9);
+
+    std::vector<option<int>> nested{1, null, 2};
+    auto flat = nested | std::views::join;
+    REQUIRE(std::ranges::equal(flat, std::vector<int>{1, 2}));
+}